@@ -35,6 +35,8 @@
 #  include "sysc/communication/sc_host_mutex.h"
 #endif
 
+#include <cstdlib>
+
 namespace sc_core {
 
 // ----------------------------------------------------------------------------
@@ -194,6 +196,152 @@ private:
 #endif // ! SC_DISABLE_ASYNC_UPDATES
 };
 
+// ----------------------------------------------------------------------------
+//  CLASS : sc_prim_channel_registry::update_workers
+//
+//  Threads that update chunks of the update list in parallel with the
+//  kernel thread, and the notifications they defer
+//  FOR INTERNAL USE ONLY!
+// ----------------------------------------------------------------------------
+
+class sc_prim_channel_registry::update_workers
+{
+#if !defined(WIN32) && !defined(_WIN32)
+public:
+
+    explicit update_workers( unsigned int num_threads_ )
+      : m_round( 0 ), m_stop( false ), m_channels_p( 0 ), m_num_chunks( 0 ),
+        m_next_chunk( 0 ), m_busy( 0 )
+    {
+	pthread_mutex_init( &m_mutex, NULL );
+	pthread_cond_init( &m_start_cond, NULL );
+	pthread_cond_init( &m_done_cond, NULL );
+	// the kernel thread is one of the update threads
+	for ( unsigned int i = 1; i < num_threads_; i++ ) {
+	    pthread_t thread;
+	    if ( pthread_create( &thread, NULL, thread_main, this ) != 0 )
+		break; // update with the threads we have
+	    m_threads.push_back( thread );
+	}
+    }
+
+    ~update_workers()
+    {
+	pthread_mutex_lock( &m_mutex );
+	m_stop = true;
+	pthread_cond_broadcast( &m_start_cond );
+	pthread_mutex_unlock( &m_mutex );
+	for ( unsigned int i = 0; i < m_threads.size(); i++ )
+	    pthread_join( m_threads[i], NULL );
+	pthread_cond_destroy( &m_done_cond );
+	pthread_cond_destroy( &m_start_cond );
+	pthread_mutex_destroy( &m_mutex );
+    }
+
+    unsigned int num_threads() const
+    {
+	return m_threads.size() + 1;
+    }
+
+    // update channels_ (in the order of the serial update) in num_chunks_
+    // contiguous chunks, then apply the deferred notifications chunk by chunk
+    void update( const std::vector<sc_prim_channel*>& channels_,
+                 unsigned int num_chunks_ )
+    {
+	m_channels_p = &channels_;
+	m_num_chunks = num_chunks_;
+	m_next_chunk = 0;
+	if ( m_deferred.size() < num_chunks_ )
+	    m_deferred.resize( num_chunks_ );
+
+	pthread_mutex_lock( &m_mutex );
+	m_busy = m_threads.size();
+	m_round++;
+	pthread_cond_broadcast( &m_start_cond );
+	pthread_mutex_unlock( &m_mutex );
+
+	update_chunks();
+
+	pthread_mutex_lock( &m_mutex );
+	while ( m_busy != 0 )
+	    pthread_cond_wait( &m_done_cond, &m_mutex );
+	pthread_mutex_unlock( &m_mutex );
+
+	for ( unsigned int c = 0; c < num_chunks_; c++ ) {
+	    sc_deferred_updates& deferred = m_deferred[c];
+	    for ( unsigned int i = 0; i < deferred.size(); i++ ) {
+		if ( deferred[i].m_reset_p )
+		    deferred[i].m_reset_p->notify_processes();
+		else
+		    deferred[i].m_event_p->notify( deferred[i].m_delay );
+	    }
+	    deferred.clear();
+	}
+	m_channels_p = 0;
+    }
+
+private:
+
+    static void* thread_main( void* arg_p )
+    {
+	update_workers* workers_p = (update_workers*)arg_p;
+	unsigned long   round = 0;
+
+	pthread_mutex_lock( &workers_p->m_mutex );
+	for ( ;; ) {
+	    while ( !workers_p->m_stop && workers_p->m_round == round )
+		pthread_cond_wait( &workers_p->m_start_cond,
+		                   &workers_p->m_mutex );
+	    if ( workers_p->m_stop )
+		break;
+	    round = workers_p->m_round;
+	    pthread_mutex_unlock( &workers_p->m_mutex );
+
+	    workers_p->update_chunks();
+
+	    pthread_mutex_lock( &workers_p->m_mutex );
+	    if ( --workers_p->m_busy == 0 )
+		pthread_cond_signal( &workers_p->m_done_cond );
+	}
+	pthread_mutex_unlock( &workers_p->m_mutex );
+	return NULL;
+    }
+
+    // take chunks until none is left; run by all update threads
+    void update_chunks()
+    {
+	const std::vector<sc_prim_channel*>& channels = *m_channels_p;
+	for ( ;; ) {
+	    unsigned int c = __atomic_fetch_add( &m_next_chunk, 1,
+	                                         __ATOMIC_RELAXED );
+	    if ( c >= m_num_chunks )
+		break;
+	    std::size_t first = channels.size() * c / m_num_chunks;
+	    std::size_t last = channels.size() * ( c + 1 ) / m_num_chunks;
+
+	    sc_deferred_updates_p = &m_deferred[c];
+	    for ( std::size_t i = first; i < last; i++ )
+		channels[i]->perform_update();
+	    sc_deferred_updates_p = 0;
+	}
+    }
+
+private:
+    std::vector<pthread_t>                m_threads;
+    pthread_mutex_t                       m_mutex;
+    pthread_cond_t                        m_start_cond;
+    pthread_cond_t                        m_done_cond;
+    unsigned long                         m_round;      // update phases
+    bool                                  m_stop;
+    const std::vector<sc_prim_channel*>*  m_channels_p;
+    unsigned int                          m_num_chunks;
+    unsigned int                          m_next_chunk; // atomic
+    unsigned int                          m_busy;       // threads updating
+    std::vector<sc_deferred_updates>      m_deferred;   // per chunk
+
+#endif // !defined(WIN32) && !defined(_WIN32)
+};
+
 // ----------------------------------------------------------------------------
 //  CLASS : sc_prim_channel_registry
 //
@@ -274,7 +422,9 @@ sc_prim_channel_registry::async_request_update( sc_prim_channel& prim_channel_ )
 // |"sc_prim_channel_registry::perform_update"
 // |
 // | This method updates the values of the primitive channels in its update
-// | lists.
+// | lists. With enough channels pending and more than one update thread, the
+// | list is cut into chunks that are updated in parallel (see 
+// | update_workers); otherwise the channels are updated in list order.
 // +----------------------------------------------------------------------------
 void
 sc_prim_channel_registry::perform_update()
@@ -297,6 +447,33 @@ sc_prim_channel_registry::perform_update()
 
     now_p = m_update_list_p;
     m_update_list_p = (sc_prim_channel*)sc_prim_channel::list_end;
+
+#if !defined(WIN32) && !defined(_WIN32)
+    if ( m_update_threads > 1 )
+    {
+	m_update_vec.clear();
+	for ( ; now_p != (sc_prim_channel*)sc_prim_channel::list_end;
+	    now_p = now_p->m_update_next_p )
+	    m_update_vec.push_back( now_p );
+
+	unsigned int num_chunks = m_update_vec.size() /
+	                          SC_PAR_UPDATE_MIN_CHANNELS;
+	if ( num_chunks > 1 )
+	{
+	    if ( m_update_workers_p == 0 )
+		m_update_workers_p = new update_workers( m_update_threads );
+	    if ( num_chunks > m_update_workers_p->num_threads() )
+		num_chunks = m_update_workers_p->num_threads();
+	}
+	if ( num_chunks > 1 )
+	    m_update_workers_p->update( m_update_vec, num_chunks );
+	else
+	    for ( unsigned int i = 0; i < m_update_vec.size(); i++ )
+		m_update_vec[i]->perform_update();
+	return;
+    }
+#endif
+
     for ( ; now_p != (sc_prim_channel*)sc_prim_channel::list_end;
 	now_p = next_p )
     {
@@ -315,9 +492,16 @@ sc_prim_channel_registry::sc_prim_channel_registry( sc_simcontext& simc_ )
   ,  m_prim_channel_vec()
   ,  m_simc( &simc_ )
   ,  m_update_list_p((sc_prim_channel*)sc_prim_channel::list_end)
+  ,  m_update_vec()
+  ,  m_update_threads(1)
+  ,  m_update_workers_p(0)
 {
     CHNL_MTX_INIT_( m_mutex ); // initialize the mutex, DM 8/22/2018
 
+    const char* update_threads = std::getenv( _SYSC_PAR_UPDATE_ENV_VAR );
+    if ( update_threads != 0 && std::atoi( update_threads ) > 1 )
+        m_update_threads = std::atoi( update_threads );
+
 #   ifndef SC_DISABLE_ASYNC_UPDATES
         m_async_update_list_p = new async_update_list();
 #   endif
@@ -330,6 +514,7 @@ sc_prim_channel_registry::~sc_prim_channel_registry()
 {
     CHNL_MTX_DESTROY_( m_mutex ); // destroy the mutex (01/11/19, RD)
     delete m_async_update_list_p;
+    delete m_update_workers_p;
 }
 
 // called when construction is done
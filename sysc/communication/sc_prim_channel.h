@@ -409,11 +409,35 @@ protected:
 };
 
 
+/**
+ *  \brief Environment variable setting the number of threads of the
+ *         update phase, the kernel thread included. Unset, or below 2, the
+ *         channels are updated by the kernel thread alone.
+ */
+#ifndef _SYSC_PAR_UPDATE_ENV_VAR
+#define _SYSC_PAR_UPDATE_ENV_VAR "SYSC_PAR_UPDATE"
+#endif
+
+/**
+ *  \brief The fewest channels an update thread is given; smaller update
+ *         phases use fewer threads, or just the kernel thread.
+ */
+#ifndef SC_PAR_UPDATE_MIN_CHANNELS
+#define SC_PAR_UPDATE_MIN_CHANNELS 32
+#endif
+
 /**************************************************************************//**
  *  \class sc_prim_channel_registry
  *
  *  \brief Registry for all primitive channels.
  *
+ *  With _SYSC_PAR_UPDATE_ENV_VAR set, the update list is cut into
+ *  contiguous chunks that are updated on several threads. update() may then
+ *  only change the state of its own channel and notify events (or the
+ *  processes of a reset signal), as the standard channels do; these
+ *  notifications are deferred and applied afterwards, chunk by chunk, so
+ *  m_delta_events is filled in the same order as by a serial update.
+ *
  *  FOR INTERNAL USE ONLY!
  *****************************************************************************/
 
@@ -471,12 +495,16 @@ private:
 
 private:
     class async_update_list;   
+    class update_workers;
 
     async_update_list*            m_async_update_list_p; // external updates.
     int                           m_construction_done;   // # of constructs.
     std::vector<sc_prim_channel*> m_prim_channel_vec;    // existing channels.
     sc_simcontext*                m_simc;                // simulator context.
     sc_prim_channel*              m_update_list_p;       // internal updates.
+    std::vector<sc_prim_channel*> m_update_vec;          // parallel updates.
+    unsigned int                  m_update_threads;      // update threads.
+    update_workers*               m_update_workers_p;    // 0 until needed.
 
     /**
      *  \brief A mutex to protect concurrent requests.
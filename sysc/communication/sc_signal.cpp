@@ -131,7 +131,10 @@ sc_lazy_kernel_event( sc_event** ev, const char* name )
     if ( !*ev ) {
         std::string kernel_name = SC_KERNEL_EVENT_PREFIX "_";
         kernel_name.append( name );
-        *ev = new sc_event( kernel_name.c_str() );
+        // publish the event only once it is constructed, see the lock-free
+        // check in the inline sc_lazy_kernel_event()
+        __atomic_store_n( ev, new sc_event( kernel_name.c_str() ),
+                          __ATOMIC_RELEASE );
     }
     return *ev;
 
@@ -226,33 +229,24 @@ template< sc_writer_policy POL >
 const sc_event&
 sc_signal<bool,POL>::value_changed_event() const
 {
-    // 02/22/2015 GL: add a lock to protect concurrent communication
-    chnl_scoped_lock lock( m_mutex );
-
-    return *sc_lazy_kernel_event(&m_change_event_p,"value_changed_event");
-    // 02/22/2015 GL: return releases the lock
+    // the channel lock is only taken to create the event
+    return *sc_lazy_kernel_event(&m_change_event_p,"value_changed_event",m_mutex);
 }
 
 template< sc_writer_policy POL >
 const sc_event&
 sc_signal<bool,POL>::posedge_event() const
 {
-    // 02/22/2015 GL: add a lock to protect concurrent communication
-    chnl_scoped_lock lock( m_mutex );
-
-    return *sc_lazy_kernel_event(&m_posedge_event_p,"posedge_event");
-    // 02/22/2015 GL: return releases the lock
+    // the channel lock is only taken to create the event
+    return *sc_lazy_kernel_event(&m_posedge_event_p,"posedge_event",m_mutex);
 }
 
 template< sc_writer_policy POL >
 const sc_event&
 sc_signal<bool,POL>::negedge_event() const
 {
-    // 02/22/2015 GL: add a lock to protect concurrent communication
-    chnl_scoped_lock lock( m_mutex );
-
-    return *sc_lazy_kernel_event(&m_negedge_event_p,"negedge_event");
-    // 02/22/2015 GL: return releases the lock
+    // the channel lock is only taken to create the event
+    return *sc_lazy_kernel_event(&m_negedge_event_p,"negedge_event",m_mutex);
 }
 
 
@@ -372,33 +366,24 @@ template< sc_writer_policy POL >
 const sc_event&
 sc_signal<sc_dt::sc_logic,POL>::value_changed_event() const
 {
-    // 02/22/2015 GL: add a lock to protect concurrent communication
-    chnl_scoped_lock lock( m_mutex );
-
-    return *sc_lazy_kernel_event(&m_change_event_p,"value_changed_event");
-    // 02/22/2015 GL: return releases the lock
+    // the channel lock is only taken to create the event
+    return *sc_lazy_kernel_event(&m_change_event_p,"value_changed_event",m_mutex);
 }
 
 template< sc_writer_policy POL >
 const sc_event&
 sc_signal<sc_dt::sc_logic,POL>::posedge_event() const
 {
-    // 02/22/2015 GL: add a lock to protect concurrent communication
-    chnl_scoped_lock lock( m_mutex );
-
-    return *sc_lazy_kernel_event(&m_posedge_event_p,"posedge_event");
-    // 02/22/2015 GL: return releases the lock
+    // the channel lock is only taken to create the event
+    return *sc_lazy_kernel_event(&m_posedge_event_p,"posedge_event",m_mutex);
 }
 
 template< sc_writer_policy POL >
 const sc_event&
 sc_signal<sc_dt::sc_logic,POL>::negedge_event() const
 {
-    // 02/22/2015 GL: add a lock to protect concurrent communication
-    chnl_scoped_lock lock( m_mutex );
-
-    return *sc_lazy_kernel_event(&m_negedge_event_p,"negedge_event");
-    // 02/22/2015 GL: return releases the lock
+    // the channel lock is only taken to create the event
+    return *sc_lazy_kernel_event(&m_negedge_event_p,"negedge_event",m_mutex);
 }
 
 
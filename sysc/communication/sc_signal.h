@@ -47,6 +47,20 @@ extern void sc_deprecated_get_new_value();
 extern void sc_deprecated_trace();
 extern sc_event * sc_lazy_kernel_event( sc_event**, const char* name );
 
+// get a lazily created kernel event of a channel; the channel lock is only
+// taken while the event does not exist yet, so that processes waiting on a
+// widely shared signal do not serialize on it
+
+inline sc_event*
+sc_lazy_kernel_event( sc_event** ev, const char* name, CHNL_MTX_TYPE_& mutex )
+{
+    sc_event* event_p = __atomic_load_n( ev, __ATOMIC_ACQUIRE );
+    if ( SC_LIKELY_( event_p != 0 ) )
+        return event_p;
+    chnl_scoped_lock lock( mutex );
+    return sc_lazy_kernel_event( ev, name );
+}
+
 inline
 bool
 sc_writer_policy_check_write::check_write( sc_object* target, bool )
@@ -121,12 +135,9 @@ public: // constructors and destructor:
     // get the value changed event
     virtual const sc_event& value_changed_event() const
     {
-        // 02/22/2015 GL: add a lock to protect concurrent communication
-        chnl_scoped_lock lock( m_mutex );
-
+        // the channel lock is only taken to create the event
         return *sc_lazy_kernel_event( &m_change_event_p
-                                    , "value_changed_event");
-        // 02/22/2015 GL: return releases the lock 
+                                    , "value_changed_event", m_mutex );
     }
 
 
@@ -45,34 +45,156 @@
 //
 
 #include "sysc/datatypes/fx/scfx_mant.h"
+#include "sysc/kernel/sc_cmnhdr.h"
+
+#include <pthread.h>
 
 
 namespace sc_dt
 {
 
-// 08/03/2015 GL: initialize scfx_mant_free_words_lock::m_mutex
-pthread_mutex_t scfx_mant_free_words_lock::m_mutex = PTHREAD_MUTEX_INITIALIZER;
+// ----------------------------------------------------------------------------
+//  block memory management
+//
+//  The free list of a thread is a stack of blocks linked through their first
+//  word. The global pool of a size class is a stack as well, only pushed
+//  onto by a compare and swap, and only emptied as a whole by an exchange,
+//  so it has no ABA problem. Blocks are never returned to the heap.
+// ----------------------------------------------------------------------------
+
+class word_list { // Entry in a free list.
+  public:
+    word_list* m_next_p;
+};
+
+struct scfx_free_list {
+    word_list* m_head_p;
+    int        m_count;
+};
+
+static SC_THREAD_LOCAL_ scfx_free_list scfx_free_lists[scfx_num_size_classes];
+static SC_THREAD_LOCAL_ bool           scfx_free_lists_used = false;
+
+static word_list*     scfx_free_pools[scfx_num_size_classes] = { 0 };
+static pthread_once_t scfx_free_once = PTHREAD_ONCE_INIT;
+static pthread_key_t  scfx_free_key;
+
+// push the blocks from first_p to last_p onto the global pool
+
+static void
+scfx_give_blocks( int size_class, word_list* first_p, word_list* last_p )
+{
+    word_list* head_p =
+        __atomic_load_n( &scfx_free_pools[size_class], __ATOMIC_RELAXED );
+    do {
+        last_p->m_next_p = head_p;
+    } while ( !__atomic_compare_exchange_n( &scfx_free_pools[size_class],
+                                            &head_p, first_p, true,
+                                            __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED ) );
+}
+
+// return all blocks of an exiting thread
+
+static void
+scfx_free_lists_exit( void* )
+{
+    for ( int size_class = 0; size_class < scfx_num_size_classes;
+          size_class ++ )
+    {
+        scfx_free_list& list = scfx_free_lists[size_class];
+        if ( list.m_head_p == 0 )
+            continue;
+        word_list* last_p = list.m_head_p;
+        while ( last_p->m_next_p != 0 )
+            last_p = last_p->m_next_p;
+        scfx_give_blocks( size_class, list.m_head_p, last_p );
+        list.m_head_p = 0;
+        list.m_count = 0;
+    }
+}
+
+static void
+scfx_free_create_key()
+{
+    pthread_key_create( &scfx_free_key, &scfx_free_lists_exit );
+}
+
+// fill the empty free list of the calling thread
+
+static void
+scfx_refill_blocks( int size_class, std::size_t block_size, int chunk )
+{
+    scfx_free_list& list = scfx_free_lists[size_class];
+
+    if ( ! scfx_free_lists_used )
+    {
+        pthread_once( &scfx_free_once, &scfx_free_create_key );
+        pthread_setspecific( scfx_free_key, &scfx_free_lists_used );
+        scfx_free_lists_used = true;
+    }
+
+    word_list* head_p = __atomic_exchange_n( &scfx_free_pools[size_class],
+                                             (word_list*)0,
+                                             __ATOMIC_ACQUIRE );
+    if ( head_p != 0 )
+    {
+        int count = 0;
+        for ( word_list* p = head_p; p != 0; p = p->m_next_p )
+            count ++;
+        list.m_head_p = head_p;
+        list.m_count = count;
+        return;
+    }
+
+    char* chunk_p = (char*)::operator new( chunk * block_size );
+    for ( int i = 0; i < chunk - 1; i ++ )
+    {
+        ((word_list*)( chunk_p + i * block_size ))->m_next_p =
+            (word_list*)( chunk_p + ( i + 1 ) * block_size );
+    }
+    ((word_list*)( chunk_p + ( chunk - 1 ) * block_size ))->m_next_p = 0;
+    list.m_head_p = (word_list*)chunk_p;
+    list.m_count = chunk;
+}
 
-// 08/03/2015 GL: constructor & destructor for scfx_mant_free_words_lock
-scfx_mant_free_words_lock::scfx_mant_free_words_lock()
+void*
+scfx_alloc_block( int size_class, std::size_t block_size, int chunk )
 {
-    pthread_mutex_lock( &m_mutex );
+    scfx_free_list& list = scfx_free_lists[size_class];
+    if ( SC_UNLIKELY_( list.m_head_p == 0 ) )
+        scfx_refill_blocks( size_class, block_size, chunk );
+
+    word_list* result = list.m_head_p;
+    list.m_head_p = result->m_next_p;
+    list.m_count --;
+    return result;
 }
 
-scfx_mant_free_words_lock::~scfx_mant_free_words_lock()
+void
+scfx_free_block( int size_class, void* block, int chunk )
 {
-    pthread_mutex_unlock( &m_mutex );
+    scfx_free_list& list = scfx_free_lists[size_class];
+    word_list* wl_p = (word_list*)block;
+
+    wl_p->m_next_p = list.m_head_p;
+    list.m_head_p = wl_p;
+    if ( SC_LIKELY_( ++ list.m_count <= 2 * chunk ) )
+        return;
+
+    // give the chunk most recently freed back
+    word_list* last_p = wl_p;
+    for ( int i = 1; i < chunk; i ++ )
+        last_p = last_p->m_next_p;
+    list.m_head_p = last_p->m_next_p;
+    list.m_count -= chunk;
+    scfx_give_blocks( size_class, wl_p, last_p );
 }
 
 // ----------------------------------------------------------------------------
 //  word memory management
 // ----------------------------------------------------------------------------
 
-class word_list { // Entry in free_words bucket.
-  public:
-    word_list* m_next_p;
-};
-
 static inline
 int
 next_pow2_index( std::size_t size )
@@ -89,56 +211,28 @@ next_pow2_index( std::size_t size )
     return index;
 }
 
-static word_list* free_words[32] = { 0 };
+static const int ALLOC_SIZE = 128;
     
 word*
 scfx_mant::alloc_word( std::size_t size )
 {
-    // 08/03/2015 GL: to protect global array free_words
-    // 08/03/2015 GL: scfx_mant_free_words_lock constructor acquires the mutex
-    scfx_mant_free_words_lock m_scfx_mant_free_words_lock; 
-
-    const int ALLOC_SIZE = 128;
-
     int slot_index = next_pow2_index( size );
 
     int alloc_size = ( 1 << slot_index );
 
-    word_list*& slot = free_words[slot_index];
-
-    if( ! slot )
-    {
-        slot = new word_list[ALLOC_SIZE * alloc_size];
-	int i;
-	for( i = 0; i < alloc_size*(ALLOC_SIZE-1) ; i+=alloc_size )
-	{
-	    slot[i].m_next_p = &slot[i+alloc_size];
-	}
-	slot[i].m_next_p = 0;
-    }
-
-    word* result = (word*)slot;
-    free_words[slot_index] = slot[0].m_next_p;
-    return result;
-    // 08/03/2015 GL: scfx_mant_free_words_lock destructor releases the mutex
+    return (word*)scfx_alloc_block( slot_index,
+                                    alloc_size * sizeof( word_list ),
+                                    ALLOC_SIZE );
 }
 
 void
 scfx_mant::free_word( word* array, std::size_t size )
 {
-    // 08/03/2015 GL: to protect global array free_words
-    // 08/03/2015 GL: scfx_mant_free_words_lock constructor acquires the mutex
-    scfx_mant_free_words_lock m_scfx_mant_free_words_lock; 
-
     if( array && size )
     {
         int slot_index = next_pow2_index( size );
-	word_list* wl_p = (word_list*)array;
-
-	wl_p->m_next_p = free_words[slot_index];
-	free_words[slot_index] = wl_p;
+	scfx_free_block( slot_index, array, ALLOC_SIZE );
     }
-    // 08/03/2015 GL: scfx_mant_free_words_lock destructor releases the mutex
 }
 
 } // namespace sc_dt
@@ -54,7 +54,6 @@
 #include "sysc/datatypes/fx/scfx_utils.h"
 #include "sysc/kernel/sc_macros.h"
 
-#include <pthread.h> // 08/03/2015 GL: to implement scfx_mant_free_words_lock
 
 
 namespace sc_dt
@@ -69,14 +68,28 @@ typedef unsigned int  word;       // Using int because of 64-bit machines.
 typedef unsigned short half_word;
 
 /**
- *  \brief A scoped mutex for static word_list* free_words.
+ *  \brief The size classes of the fixed-point blocks: 0 to 31 for the
+ *         mantissa words (a power of two of words each), and one for the
+ *         scfx_rep objects.
  */
-// 08/03/2015 GL.
-struct scfx_mant_free_words_lock {
-    static pthread_mutex_t m_mutex;
-    explicit scfx_mant_free_words_lock();
-    ~scfx_mant_free_words_lock();
-};
+const int scfx_rep_size_class = 32;
+const int scfx_num_size_classes = 33;
+
+/**
+ *  \brief Allocate a block of size_class, block_size bytes. Each thread
+ *         takes blocks from a free list of its own, without any lock. An
+ *         empty list takes all blocks of the global pool of the class
+ *         (one atomic exchange), or else chunk new blocks.
+ */
+void* scfx_alloc_block( int size_class, std::size_t block_size, int chunk );
+
+/**
+ *  \brief Return a block of scfx_alloc_block to the free list of the
+ *         calling thread. A list grown beyond two chunks gives one chunk
+ *         of blocks back to the global pool (one atomic compare and
+ *         swap), and the list of an exiting thread goes back entirely.
+ */
+void scfx_free_block( int size_class, void* block, int chunk );
 
 
 // ----------------------------------------------------------------------------
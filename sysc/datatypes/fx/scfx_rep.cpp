@@ -89,20 +89,6 @@ n_word( int x )
     return ( x + bits_in_word - 1 ) / bits_in_word;
 }
 
-// 08/03/2015 GL: initialize scfx_rep_list_lock::m_mutex
-pthread_mutex_t scfx_rep_list_lock::m_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-// 08/03/2015 GL: constructor & destructor for scfx_rep_list_lock
-scfx_rep_list_lock::scfx_rep_list_lock()
-{
-    pthread_mutex_lock( &m_mutex );
-}
-
-scfx_rep_list_lock::~scfx_rep_list_lock()
-{
-    pthread_mutex_unlock( &m_mutex );
-}
-
 // 08/03/2015 GL: initialize scfx_rep_pow10_fx_lock::m_mutex
 pthread_mutex_t scfx_rep_pow10_fx_lock::m_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -402,60 +388,32 @@ scfx_rep::scfx_rep( const scfx_rep& a )
 //  Memory management for class scfx_rep.
 // ----------------------------------------------------------------------------
 
-union scfx_rep_node
-{
-    char           data[sizeof( scfx_rep )];
-    scfx_rep_node* next;
-};
-
+// the blocks come from the free list of the calling thread (see
+// scfx_alloc_block), so no lock is taken
 
-static scfx_rep_node* list = 0;
+static const int ALLOC_SIZE = 1024;
 
 
 void*
 scfx_rep::operator new( std::size_t size )
 {
-    // 08/03/2015 GL: to protect global data list
-    // 08/03/2015 GL: scfx_rep_list_lock constructor acquires the mutex
-    scfx_rep_list_lock m_scfx_rep_list_lock;
-
-    const int ALLOC_SIZE = 1024;
-
     if( size != sizeof( scfx_rep ) )
 	return ::operator new( size );
 
-    if( ! list )
-    {
-	list = new scfx_rep_node[ALLOC_SIZE];
-	for( int i = 0; i < ALLOC_SIZE - 1; i ++ )
-	    list[i].next = list + i + 1;
-	list[ALLOC_SIZE - 1].next = 0;
-    }
-
-    scfx_rep* ptr = reinterpret_cast<scfx_rep*>( list->data );
-    list = list->next;
-
-    return ptr;
-    // 08/03/2015 GL: scfx_rep_list_lock destructor releases the mutex
+    return scfx_alloc_block( scfx_rep_size_class, sizeof( scfx_rep ),
+                             ALLOC_SIZE );
 }
 
 
 void scfx_rep::operator delete( void* ptr, std::size_t size )
 {
-    // 08/03/2015 GL: to protect global data list
-    // 08/03/2015 GL: scfx_rep_list_lock constructor acquires the mutex
-    scfx_rep_list_lock m_scfx_rep_list_lock; 
-
     if( size != sizeof( scfx_rep ) )
     {
 	::operator delete( ptr );
 	return;
     }
 
-    scfx_rep_node* node = static_cast<scfx_rep_node*>( ptr );
-    node->next = list;
-    list = node;
-    // 08/03/2015 GL: scfx_rep_list_lock destructor releases the mutex
+    scfx_free_block( scfx_rep_size_class, ptr, ALLOC_SIZE );
 }
 
 
@@ -68,6 +68,7 @@
 
 
 #include <climits>
+#include <pthread.h> // for the pow10 and string locks
 
 #include "sysc/datatypes/fx/scfx_mant.h"
 #include "sysc/datatypes/fx/scfx_params.h"
@@ -108,16 +109,6 @@ const int min_mant = 4;
 const int bits_in_int  = sizeof(int)  * CHAR_BIT;
 const int bits_in_word = sizeof(word) * CHAR_BIT;
 
-/**
- *  \brief A scoped mutex for static scfx_rep_node* list.
- */
-// 08/03/2015 GL.
-struct scfx_rep_list_lock {
-    static pthread_mutex_t m_mutex;
-    explicit scfx_rep_list_lock();
-    ~scfx_rep_list_lock();
-};
-
 /**
  *  \brief A scoped mutex for static scfx_pow10 pow10_fx.
  */
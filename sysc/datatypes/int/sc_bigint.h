@@ -83,97 +83,100 @@ template< int W = SC_MAX_NBITS >
 template< int W >
 #endif
 class sc_bigint
-    : public sc_signed
+    : private sc_nb_storage< DIV_CEIL(W) >,
+      public sc_signed
 {
+    typedef sc_nb_storage< DIV_CEIL(W) > storage_type;
+
 public:
 
     // constructors
 
     sc_bigint()
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{}
 
     sc_bigint( const sc_bigint<W>& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_signed& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_signed_subref& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     template< class T >
     sc_bigint( const sc_generic_base<T>& a )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ a->to_sc_signed(*this); }
 
     sc_bigint( const sc_unsigned& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_unsigned_subref& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( const char* v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( int64 v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( uint64 v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( long v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( unsigned long v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( int v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( unsigned int v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( double v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
   
     sc_bigint( const sc_bv_base& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_lv_base& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
 #ifdef SC_INCLUDE_FX
 
     explicit sc_bigint( const sc_fxval& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     explicit sc_bigint( const sc_fxval_fast& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     explicit sc_bigint( const sc_fxnum& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
     explicit sc_bigint( const sc_fxnum_fast& v )
-	: sc_signed( W )
+	: sc_signed( W, storage_type::digits() )
 	{ *this = v; }
 
 #endif
@@ -184,7 +187,7 @@ public:
     // destructor
 
     ~sc_bigint()
-	{}
+	{ if ( storage_type::digits() ) sc_signed::release_digits(); }
 
 #endif
  
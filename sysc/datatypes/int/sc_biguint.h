@@ -83,97 +83,100 @@ template< int W = SC_MAX_NBITS >
 template< int W >
 #endif
 class sc_biguint
-    : public sc_unsigned
+    : private sc_nb_storage< DIV_CEIL(W + 1) >,
+      public sc_unsigned
 {
+    typedef sc_nb_storage< DIV_CEIL(W + 1) > storage_type;
+
 public:
 
     // constructors
 
     sc_biguint()
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{}
 
     sc_biguint( const sc_biguint<W>& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_unsigned& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_unsigned_subref& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     template< class T >
     sc_biguint( const sc_generic_base<T>& a )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ a->to_sc_unsigned(*this); }
 
     sc_biguint( const sc_signed& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_signed_subref& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( const char* v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; } 
 
     sc_biguint( int64 v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( uint64 v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( long v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( unsigned long v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( int v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; } 
 
     sc_biguint( unsigned int v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( double v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
   
     sc_biguint( const sc_bv_base& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_lv_base& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
 #ifdef SC_INCLUDE_FX
 
     explicit sc_biguint( const sc_fxval& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     explicit sc_biguint( const sc_fxval_fast& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     explicit sc_biguint( const sc_fxnum& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
     explicit sc_biguint( const sc_fxnum_fast& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, storage_type::digits() )
 	{ *this = v; }
 
 #endif
@@ -184,7 +187,7 @@ public:
     // destructor
 
     ~sc_biguint()
-	{}
+	{ if ( storage_type::digits() ) sc_unsigned::release_digits(); }
 
 #endif
  
@@ -153,6 +153,23 @@ typedef int small_type;
 // store x bits. x is a positive number.
 #define DIV_CEIL(x) DIV_CEIL2(x, BITS_PER_DIGIT)
 
+// SC_NB_LIMB64 selects 64-bit limbs for the large multiplication,
+// division and remainder of sc_signed and sc_unsigned (vec_mul,
+// vec_div_large and vec_rem_large). The values stay in 30-bit digits;
+// these routines repack their operands into 64-bit limbs, compute with
+// 128-bit products, and unpack the result. This needs unsigned
+// __int128, so the 30-bit routines are kept where it is missing.
+#if defined(SC_NB_LIMB64) && !defined(__SIZEOF_INT128__)
+#undef SC_NB_LIMB64
+#endif
+
+// sc_bigint<W> and sc_biguint<W> keep their digits inside the object up
+// to this width, and on the heap above it, so that very wide numbers do
+// not take up the stack of a thread process.
+#ifndef SC_NB_INLINE_NBITS
+#define SC_NB_INLINE_NBITS 8192
+#endif
+
 #ifdef SC_MAX_NBITS
 extern const int MAX_NDIGITS;
 // Consider a number with x bits another with y bits. The maximum
@@ -172,6 +189,31 @@ extern const int MAX_NDIGITS;
 
 typedef unsigned int sc_digit;	// 32-bit unsigned integer
 
+// Storage for the ND digits of an sc_bigint or sc_biguint. It is a base
+// class of them, so that it exists before their sc_signed or sc_unsigned
+// base is constructed on it. Numbers wider than SC_NB_INLINE_NBITS, and
+// all numbers when SC_MAX_NBITS is defined, have no storage here, and
+// digits() is 0.
+#ifdef SC_MAX_NBITS
+template< int ND, bool INLINE = false >
+#else
+template< int ND, bool INLINE = ( ND <= DIV_CEIL(SC_NB_INLINE_NBITS) ) >
+#endif
+class sc_nb_storage
+{
+protected:
+    sc_digit* digits() { return 0; }
+};
+
+template< int ND >
+class sc_nb_storage<ND, true>
+{
+protected:
+    sc_digit* digits() { return m_digits; }
+private:
+    sc_digit m_digits[ND];
+};
+
 // Support for the long long type. This type is not in the standard
 // but is usually supported by compilers.
 #ifndef _WIN32
@@ -168,7 +168,11 @@ mul_on_help_signed(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS];
 #else
-    sc_digit *d = new sc_digit[nd];
+    // The product of numbers up to the inline width of sc_bigint and
+    // sc_biguint has at most one digit more than that width.
+    sc_digit d_local[DIV_CEIL(SC_NB_INLINE_NBITS) + 1];
+    sc_digit *d = (nd <= DIV_CEIL(SC_NB_INLINE_NBITS) + 1) ?
+                  d_local : new sc_digit[nd];
 #endif
   
     vec_zero(nd, d);
@@ -188,7 +192,8 @@ mul_on_help_signed(small_type &us,
     COPY_DIGITS(us, unb, old_und, ud, unb + vnb, nd, d);
     
 #ifndef SC_MAX_NBITS
-    delete [] d;
+    if (d != d_local)
+      delete [] d;
 #endif
     
   }
@@ -243,7 +248,11 @@ mul_on_help_unsigned(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS];
 #else
-    sc_digit *d = new sc_digit[nd];
+    // The product of numbers up to the inline width of sc_bigint and
+    // sc_biguint has at most one digit more than that width.
+    sc_digit d_local[DIV_CEIL(SC_NB_INLINE_NBITS) + 1];
+    sc_digit *d = (nd <= DIV_CEIL(SC_NB_INLINE_NBITS) + 1) ?
+                  d_local : new sc_digit[nd];
 #endif
   
     vec_zero(nd, d);
@@ -263,7 +272,8 @@ mul_on_help_unsigned(small_type &us,
     COPY_DIGITS(us, unb, old_und, ud, unb + vnb, nd, d);
     
 #ifndef SC_MAX_NBITS
-    delete [] d;
+    if (d != d_local)
+      delete [] d;
 #endif
     
   }
@@ -993,124 +993,548 @@ vec_sub_small_on(int ulen, sc_digit *u, sc_digit v)
 
 }
 
-// Compute w = u * v, where w, u, and v are vectors.
-void
-vec_mul(int ulen, const sc_digit *u,
-        int vlen, const sc_digit *vbegin, 
-        sc_digit *wbegin)
+// ----------------------------------------------------------------------------
+//  SECTION: Word routines for the large multiplication and division.
+//
+//  These routines work on vectors of words described by a word traits
+//  class: the 30-bit digits themselves, or the 64-bit limbs the digits are
+//  repacked into if SC_NB_LIMB64 is defined. On limbs, a product takes
+//  (30/64)^2, or about a fifth, of the multiplications on digits.
+// ----------------------------------------------------------------------------
+
+// Words of the scratch space kept on the stack; larger operands use the
+// heap.
+#define SC_NB_LOCAL_WORDS 256
+
+// Compute w += u * v with the schoolbook method, where w, u, and v are
+// vectors, and w has ulen + vlen digits. The product of two digits plus
+// two carries fits in 64 bits, so a pair of digits takes one
+// multiplication instead of four on half digits.
+static void
+vec_mul_basecase(int ulen, const sc_digit *u,
+                 int vlen, const sc_digit *v,
+                 sc_digit *w)
 {
+  for (int i = 0; i < ulen; ++i) {
 
-  /* Consider u = Ax + B and v = Cx + D where x is equal to
-     HALF_DIGIT_RADIX. In other words, A is the higher half of u and
-     B is the lower half of u. The interpretation for v is
-     similar. Then, we have the following picture:
+#ifdef DEBUG_SYSTEMC
+    // The overflow bits must be zero.
+    assert(u[i] == (u[i] & DIGIT_MASK));
+#endif
 
-              u_h     u_l
-     u: -------- --------
-               A        B
+    uint64 ui = u[i];
+    uint64 carry = 0;
+    sc_digit *wi = w + i;
 
-              v_h     v_l
-     v: -------- --------
-               C        D
- 
-     result (d):                     
-     carry_before:                           -------- --------
-                                              carry_h  carry_l
-     result_before:        -------- -------- -------- --------
-                               R1_h     R1_l     R0_h     R0_l
-                                             -------- --------
-                                                 BD_h     BD_l
-                                    -------- --------
-                                        AD_h     AD_l
-                                    -------- --------
-                                        BC_h     BC_l
-                           -------- --------
-                               AC_h     AC_l
-     result_after:         -------- -------- -------- --------
-                              R1_h'    R1_l'    R0_h'    R0_l'
- 
-     prod_l = R0_h|R0_l + B * D  + 0|carry_l
-            = R0_h|R0_l + BD_h|BD_l + 0|carry_l
- 
-     prod_h = A * D + B * C + high_half(prod_l) + carry_h
-            = AD_h|AD_l + BC_h|BC_l + high_half(prod_l) + 0|carry_h
- 
-     carry = A * C + high_half(prod_h)
-           = AC_h|AC_l + high_half(prod_h)
- 
-     R0_l' = low_half(prod_l)
- 
-     R0_h' = low_half(prod_h)
- 
-     R0 = high_half(prod_h)|low_half(prod_l)
- 
-     where '|' is the concatenation operation and the suffixes 0 and 1
-     show the iteration number, i.e., 0 is the current iteration and 1
-     is the next iteration.
- 
-     NOTE: sc_max(prod_l, prod_h, carry) <= 2 * x^2 - 1, so any
-     of these numbers can be stored in a digit.
+    for (int j = 0; j < vlen; ++j) {
+      carry += ui * v[j] + wi[j];
+      wi[j] = (sc_digit) (carry & DIGIT_MASK);
+      carry >>= BITS_PER_DIGIT;
+    }
 
-     NOTE: low_half(u) returns the lower BITS_PER_HALF_DIGIT of u,
-     whereas high_half(u) returns the rest of the bits, which may
-     contain more bits than BITS_PER_HALF_DIGIT.  
-  */
+    wi[vlen] = (sc_digit) carry;
+  }
+}
 
-#ifdef DEBUG_SYSTEMC
-  assert((ulen > 0) && (u != NULL));
-  assert((vlen > 0) && (vbegin != NULL));
-  assert(wbegin != NULL);
+// The 30-bit digits.
+struct sc_digit_words
+{
+  typedef sc_digit word;
+  typedef uint64   dword;
+
+  static const int bits = BITS_PER_DIGIT;
+
+  // Operands of at least this many words are multiplied with
+  // Karatsuba's method.
+  static const int karatsuba_threshold = 40;
+
+  static word lo(dword d)
+    { return (word) (d & DIGIT_MASK); }
+
+  static dword hi(dword d)
+    { return d >> BITS_PER_DIGIT; }
+
+  // Compute w = u * v with the schoolbook method.
+  static void mul_basecase(int ulen, const word *u,
+                           int vlen, const word *v, word *w)
+    {
+      vec_zero(ulen + vlen, w);
+      vec_mul_basecase(ulen, u, vlen, v, w);
+    }
+};
+
+#ifdef SC_NB_LIMB64
+
+typedef uint64            sc_limb;
+typedef unsigned __int128 sc_dlimb;
+
+#define BITS_PER_LIMB 64
+
+// The 64-bit limbs.
+struct sc_limb_words
+{
+  typedef sc_limb  word;
+  typedef sc_dlimb dword;
+
+  static const int bits = BITS_PER_LIMB;
+
+  static const int karatsuba_threshold = 32;
+
+  static word lo(dword d)
+    { return (word) d; }
+
+  static dword hi(dword d)
+    { return d >> BITS_PER_LIMB; }
+
+  static void mul_basecase(int ulen, const word *u,
+                           int vlen, const word *v, word *w)
+    {
+      for (int i = 0; i < ulen + vlen; ++i)
+        w[i] = 0;
+
+      for (int i = 0; i < ulen; ++i) {
+        dword ui = u[i];
+        word carry = 0;
+        word *wi = w + i;
+
+        for (int j = 0; j < vlen; ++j) {
+          dword p = ui * v[j] + wi[j] + carry;
+          wi[j] = (word) p;
+          carry = (word) (p >> BITS_PER_LIMB);
+        }
+
+        wi[vlen] = carry;
+      }
+    }
+};
+
+#endif // SC_NB_LIMB64
+
+// Compute r += a, where r has rlen >= alen words, and return the carry out
+// of r.
+template< class W >
+static typename W::word
+words_add_on(int rlen, typename W::word *r,
+             int alen, const typename W::word *a)
+{
+  typename W::dword carry = 0;
+
+  for (int i = 0; i < alen; ++i) {
+    carry += (typename W::dword) r[i] + a[i];
+    r[i] = W::lo(carry);
+    carry = W::hi(carry);
+  }
+
+  for (int i = alen; (i < rlen) && carry; ++i) {
+    carry += r[i];
+    r[i] = W::lo(carry);
+    carry = W::hi(carry);
+  }
+
+  return (typename W::word) carry;
+}
+
+// Compute r -= a, where r has rlen >= alen words, and return the borrow out
+// of r.
+template< class W >
+static typename W::word
+words_sub_on(int rlen, typename W::word *r,
+             int alen, const typename W::word *a)
+{
+  typename W::word borrow = 0;
+
+  for (int i = 0; i < alen; ++i) {
+    typename W::dword d = (typename W::dword) r[i] - a[i] - borrow;
+    r[i] = W::lo(d);
+    borrow = (W::hi(d) != 0);
+  }
+
+  for (int i = alen; (i < rlen) && borrow; ++i) {
+    typename W::dword d = (typename W::dword) r[i] - borrow;
+    r[i] = W::lo(d);
+    borrow = (W::hi(d) != 0);
+  }
+
+  return borrow;
+}
+
+// The scratch space of words_karatsuba() for n words.
+template< class W >
+static int
+words_karatsuba_scratch(int n)
+{
+  if (n < W::karatsuba_threshold)
+    return 0;
+
+  int h = n - n / 2;
+  return 4 * (h + 1) + words_karatsuba_scratch<W>(h + 1);
+}
+
+// Compute w = u * v, where u and v have n words each, and w has 2 * n
+// words, with Karatsuba's method: for u = u1 * B^m + u0 and v = v1 * B^m
+// + v0,
+//
+//   u * v = u1 * v1 * B^2m + ((u0 + u1) * (v0 + v1) - u0 * v0 - u1 * v1) *
+//           B^m + u0 * v0,
+//
+// i.e., three products of half the length instead of four. s is scratch
+// space of words_karatsuba_scratch<W>(n) words.
+template< class W >
+static void
+words_karatsuba(int n, const typename W::word *u,
+                const typename W::word *v, typename W::word *w,
+                typename W::word *s)
+{
+  typedef typename W::word word;
+
+  if (n < W::karatsuba_threshold) {
+    W::mul_basecase(n, u, n, v, w);
+    return;
+  }
+
+  int m = n / 2;  // Length of u0 and v0.
+  int h = n - m;  // Length of u1 and v1, h >= m.
+
+  word *su = s;                  // u0 + u1, h + 1 words
+  word *sv = su + (h + 1);       // v0 + v1, h + 1 words
+  word *t = sv + (h + 1);        // middle product, 2 * (h + 1) words
+  word *next = t + 2 * (h + 1);  // scratch space of the products
+
+  words_karatsuba<W>(m, u, v, w, next);
+  words_karatsuba<W>(h, u + m, v + m, w + 2 * m, next);
+
+  for (int i = 0; i < h; ++i) {
+    su[i] = u[m + i];
+    sv[i] = v[m + i];
+  }
+  su[h] = words_add_on<W>(h, su, m, u);
+  sv[h] = words_add_on<W>(h, sv, m, v);
+
+  words_karatsuba<W>(h + 1, su, sv, t, next);
+
+  words_sub_on<W>(2 * (h + 1), t, 2 * m, w);
+  words_sub_on<W>(2 * (h + 1), t, 2 * h, w + 2 * m);
+
+  // The middle product is less than B^(2h+1), and the whole product fits
+  // in w.
+  words_add_on<W>(2 * n - m, w + m, 2 * (h + 1), t);
+}
+
+// Compute w = u * v, where w has ulen + vlen words. An operand much longer
+// than the other is multiplied in pieces of the length of the other.
+template< class W >
+static void
+words_mul(int ulen, const typename W::word *u,
+          int vlen, const typename W::word *v, typename W::word *w)
+{
+  typedef typename W::word word;
+
+  if (ulen < vlen) {
+    words_mul<W>(vlen, v, ulen, u, w);
+    return;
+  }
+
+  if (vlen < W::karatsuba_threshold) {
+    W::mul_basecase(ulen, u, vlen, v, w);
+    return;
+  }
+
+  int n = words_karatsuba_scratch<W>(vlen) + 2 * vlen;
+
+  word local[SC_NB_LOCAL_WORDS];
+  word *s = (n <= SC_NB_LOCAL_WORDS) ? local : new word[n];
+  word *t = s + (n - 2 * vlen);  // product of a piece, 2 * vlen words
+
+  for (int i = 0; i < ulen + vlen; ++i)
+    w[i] = 0;
+
+  for (int i = 0; i < ulen; i += vlen) {
+    int k = sc_min(vlen, ulen - i);
+
+    if (k == vlen)
+      words_karatsuba<W>(vlen, u + i, v, t, s);
+    else
+      words_mul<W>(k, u + i, vlen, v, t);
+
+    words_add_on<W>(ulen + vlen - i, w + i, k + vlen, t);
+  }
+
+  if (s != local)
+    delete [] s;
+}
+
+// Compute q = x / y and r = x % y, where xlen >= ylen, the top word of y
+// is not zero, q has xlen - ylen + 1 words, and r has ylen words. This is
+// Knuth's algorithm D: the divisor is normalized so that the estimate of
+// each quotient word from the top two words is off by at most two. xn and
+// yn are scratch space of xlen + 1 and ylen words. r may be y.
+template< class W >
+static void
+words_divrem(int xlen, const typename W::word *x,
+             int ylen, const typename W::word *y,
+             typename W::word *q, typename W::word *r,
+             typename W::word *xn, typename W::word *yn)
+{
+  typedef typename W::word  word;
+  typedef typename W::dword dword;
+
+  const int bits = W::bits;
+
+  if (ylen == 1) {
+    dword rem = 0;
+    for (int i = xlen - 1; i >= 0; --i) {
+      dword t = (rem << bits) | x[i];
+      q[i] = (word) (t / y[0]);
+      rem = t % y[0];
+    }
+    r[0] = (word) rem;
+    return;
+  }
+
+  // Normalize: shift y left so that its top bit is set, and x with it.
+  int s = 0;
+  for (word top = y[ylen - 1]; ! (top >> (bits - 1)); top <<= 1)
+    ++s;
+
+  for (int i = ylen - 1; i > 0; --i)
+    yn[i] = W::lo((dword) y[i] << s) | (s ? y[i - 1] >> (bits - s) : 0);
+  yn[0] = W::lo((dword) y[0] << s);
+
+  xn[xlen] = s ? x[xlen - 1] >> (bits - s) : 0;
+  for (int i = xlen - 1; i > 0; --i)
+    xn[i] = W::lo((dword) x[i] << s) | (s ? x[i - 1] >> (bits - s) : 0);
+  xn[0] = W::lo((dword) x[0] << s);
+
+  word y1 = yn[ylen - 1];
+  word y2 = yn[ylen - 2];
+
+  for (int j = xlen - ylen; j >= 0; --j) {
+
+    // Estimate the quotient word, and correct it by the next word.
+    dword num = ((dword) xn[j + ylen] << bits) | xn[j + ylen - 1];
+    dword qhat = num / y1;
+    dword rhat = num - qhat * y1;
+
+    while ((W::hi(qhat) != 0) ||
+           (qhat * y2 > ((rhat << bits) | xn[j + ylen - 2]))) {
+      --qhat;
+      rhat += y1;
+      if (W::hi(rhat) != 0)
+        break;
+    }
+
+    // Multiply and subtract: xn[j .. j + ylen] -= qhat * yn. qhat now
+    // fits in a word, so each product is a single word by word one.
+    word qw = (word) qhat;
+    dword carry = 0;
+    word borrow = 0;
+
+    for (int i = 0; i < ylen; ++i) {
+      dword p = (dword) qw * yn[i] + carry;
+      carry = W::hi(p);
+
+      dword d = (dword) xn[i + j] - W::lo(p) - borrow;
+      xn[i + j] = W::lo(d);
+      borrow = (W::hi(d) != 0);
+    }
+
+    dword d = (dword) xn[j + ylen] - carry - borrow;
+    xn[j + ylen] = W::lo(d);
+
+    // The estimate was one too large: add yn back.
+    if (W::hi(d) != 0) {
+      --qw;
+      word carry_out = words_add_on<W>(ylen, xn + j, ylen, yn);
+      xn[j + ylen] = W::lo((dword) xn[j + ylen] + carry_out);
+    }
+
+    q[j] = qw;
+  }
+
+  // Denormalize the remainder.
+  for (int i = 0; i < ylen; ++i)
+    r[i] = (xn[i] >> s) |
+           (s ? W::lo((dword) xn[i + 1] << (bits - s)) : 0);
+}
+
+#ifdef SC_NB_LIMB64
+
+// The number of limbs to hold ulen digits.
+static inline int
+limbs_of(int ulen)
+{
+  return DIV_CEIL2(ulen * BITS_PER_DIGIT, BITS_PER_LIMB);
+}
+
+// Set (sc_limb) x = (sc_digit) u. Return the length of x without its
+// leading zeros.
+static int
+vec_to_limbs(int ulen, const sc_digit *u, sc_limb *x)
+{
+  int xlen = 0;
+  int nbits = 0;
+  sc_limb acc = 0;
+
+  for (int i = 0; i < ulen; ++i) {
+    sc_limb d = u[i] & DIGIT_MASK;
+    acc |= d << nbits;
+    nbits += BITS_PER_DIGIT;
+    if (nbits >= BITS_PER_LIMB) {
+      x[xlen++] = acc;
+      nbits -= BITS_PER_LIMB;
+      acc = nbits ? d >> (BITS_PER_DIGIT - nbits) : 0;
+    }
+  }
+
+  if (nbits)
+    x[xlen++] = acc;
+
+  while ((xlen > 0) && (! x[xlen - 1]))
+    --xlen;
+
+  return xlen;
+}
+
+// Set (sc_digit) u = (sc_limb) x, filling all ulen digits of u.
+static void
+vec_from_limbs(int xlen, const sc_limb *x, int ulen, sc_digit *u)
+{
+  for (int i = 0; i < ulen; ++i) {
+    int nbit = i * BITS_PER_DIGIT;
+    int k = nbit / BITS_PER_LIMB;
+    int shift = nbit % BITS_PER_LIMB;
+
+    if (k >= xlen) {
+      vec_zero(i, ulen, u);
+      return;
+    }
+
+    sc_limb d = x[k] >> shift;
+    if ((shift + BITS_PER_DIGIT > BITS_PER_LIMB) && (k + 1 < xlen))
+      d |= x[k + 1] << (BITS_PER_LIMB - shift);
+
+    u[i] = (sc_digit) (d & DIGIT_MASK);
+  }
+}
+
+#endif // SC_NB_LIMB64
+
+// Compute w = u / v, or w = u % v if rem is true, filling ulen digits of
+// w. v is not zero.
+static void
+vec_divrem(int ulen, const sc_digit *u,
+           int vlen, const sc_digit *v, sc_digit *w, bool rem)
+{
+#ifdef SC_NB_LIMB64
+  typedef sc_limb_words words;
+
+  int xsize = limbs_of(ulen);
+  int ysize = limbs_of(vlen);
+#else
+  typedef sc_digit_words words;
+
+  int xsize = ulen;
+  int ysize = vlen;
 #endif
 
-#define prod_h carry
+  typedef words::word word;
 
-  const sc_digit *uend = (u + ulen);
-  const sc_digit *vend = (vbegin + vlen);
+  // x and y, their normalized copies xn and yn, and the quotient q.
+  int n = xsize + ysize + (xsize + 1) + ysize + xsize;
 
-  while (u < uend) {
+  word local[SC_NB_LOCAL_WORDS];
+  word *x = (n <= SC_NB_LOCAL_WORDS) ? local : new word[n];
+  word *y = x + xsize;
+  word *xn = y + ysize;
+  word *yn = xn + xsize + 1;
+  word *q = yn + ysize;
 
-    sc_digit u_h = (*u++);        // A|B
-    sc_digit u_l = low_half(u_h); // B
-    u_h = high_half(u_h);           // A
+#ifdef SC_NB_LIMB64
+  int xlen = vec_to_limbs(ulen, u, x);
+  int ylen = vec_to_limbs(vlen, v, y);
+#else
+  vec_copy(ulen, x, u);
+  vec_copy(vlen, y, v);
+  int xlen = vec_skip_leading_zeros(ulen, x);
+  int ylen = vec_skip_leading_zeros(vlen, y);
+#endif
 
 #ifdef DEBUG_SYSTEMC
-    // The overflow bits must be zero.
-    assert(u_h == (u_h & HALF_DIGIT_MASK));
+  assert((ylen > 0) && (y[ylen - 1] != 0));
 #endif
 
-    sc_digit carry = 0;
-
-    sc_digit *w = (wbegin++);
+  // The result is res, of reslen words, 0 if it is zero.
+  const word *res = x;
+  int reslen = 0;
 
-    const sc_digit *v = vbegin;
+  if (xlen >= ylen) {
+    // The remainder is written over y, which is read only before it.
+    words_divrem<words>(xlen, x, ylen, y, q, y, xn, yn);
+    res = rem ? y : q;
+    reslen = rem ? ylen : xlen - ylen + 1;
+  }
+  else if (rem) {
+    // The quotient is zero, and the remainder is x.
+    reslen = xlen;
+  }
 
-    while (v < vend) {
+#ifdef SC_NB_LIMB64
+  vec_from_limbs(reslen, res, ulen, w);
+#else
+  for (int i = 0; i < reslen; ++i)
+    w[i] = res[i];
+  vec_zero(reslen, ulen, w);
+#endif
 
-      sc_digit v_h = (*v++);         // C|D
-      sc_digit v_l = low_half(v_h);  // D
+  if (x != local)
+    delete [] x;
+}
 
-      v_h = high_half(v_h);            // C
+// Compute w = u * v, where w, u, and v are vectors.
+void
+vec_mul(int ulen, const sc_digit *u,
+        int vlen, const sc_digit *v, sc_digit *w)
+{
 
 #ifdef DEBUG_SYSTEMC
-      // The overflow bits must be zero.
-      assert(v_h == (v_h & HALF_DIGIT_MASK));
+  assert((ulen > 0) && (u != NULL));
+  assert((vlen > 0) && (v != NULL));
+  assert(w != NULL);
 #endif
 
-      sc_digit prod_l = (*w) + u_l * v_l + low_half(carry);
+#ifdef SC_NB_LIMB64
 
-      prod_h = u_h * v_l + u_l * v_h + high_half(prod_l) + high_half(carry);
+  int xsize = limbs_of(ulen);
+  int ysize = limbs_of(vlen);
+  int n = 2 * (xsize + ysize);
 
-      (*w++) = concat(low_half(prod_h), low_half(prod_l));
+  sc_limb local[SC_NB_LOCAL_WORDS];
+  sc_limb *x = (n <= SC_NB_LOCAL_WORDS) ? local : new sc_limb[n];
+  sc_limb *y = x + xsize;
+  sc_limb *z = y + ysize;
 
-      carry = u_h * v_h + high_half(prod_h);
+  int xlen = vec_to_limbs(ulen, u, x);
+  int ylen = vec_to_limbs(vlen, v, y);
 
-    }
+  if ((xlen == 0) || (ylen == 0)) {
+    vec_zero(ulen + vlen, w);
+  }
+  else {
+    words_mul<sc_limb_words>(xlen, x, ylen, y, z);
+    vec_from_limbs(xlen + ylen, z, ulen + vlen, w);
+  }
 
-    (*w) = carry;
+  if (x != local)
+    delete [] x;
 
-  }
+#else
 
-#undef prod_h
+  if (sc_min(ulen, vlen) < sc_digit_words::karatsuba_threshold)
+    vec_mul_basecase(ulen, u, vlen, v, w);
+  else
+    words_mul<sc_digit_words>(ulen, u, vlen, v, w);
+
+#endif
 
 }
 
@@ -1202,8 +1626,7 @@ vec_mul_small_on(int ulen, sc_digit *u, sc_digit v)
 #endif
 }
 
-// Compute w = u / v, where w, u, and v are vectors. 
-// - u and v are assumed to have at least two digits as uchars.
+// Compute w = u / v, where w, u, and v are vectors.
 void
 vec_div_large(int ulen, const sc_digit *u,
               int vlen, const sc_digit *v,
@@ -1214,133 +1637,9 @@ vec_div_large(int ulen, const sc_digit *u,
   assert((ulen > 0) && (u != NULL));
   assert((vlen > 0) && (v != NULL));
   assert(w != NULL);
-  assert(BITS_PER_DIGIT >= 3 * BITS_PER_BYTE);
-#endif
-
-  // We will compute q = x / y where x = u and y = v. The reason for
-  // using x and y is that x and y are BYTE_RADIX copies of u and v,
-  // respectively. The use of BYTE_RADIX radix greatly simplifies the
-  // complexity of the division operation. These copies are also
-  // needed even when we use DIGIT_RADIX representation.
-
-  int xlen = BYTES_PER_DIGIT * ulen + 1;
-  int ylen = BYTES_PER_DIGIT * vlen;
-
-#ifdef SC_MAX_NBITS
-  uchar x[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
-  uchar y[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
-  uchar q[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
-#else
-  uchar *x = new uchar[xlen];
-  uchar *y = new uchar[ylen];
-  // valgrind complains about us accessing too far to so leave a buffer.
-  uchar *q = new uchar[(xlen - ylen) + 10];
-#endif
-
-  // q corresponds to w.
-
-  // Set (uchar) x = (sc_digit) u.
-  xlen = vec_to_char(ulen, u, xlen, x);
-
-  // Skip all the leading zeros in x.
-  while ((--xlen >= 0) && (! x[xlen])) continue;
-  xlen++;
-
-  // Set (uchar) y = (sc_digit) v.
-  ylen = vec_to_char(vlen, v, ylen, y);
-
-  // Skip all the leading zeros in y.
-  while ((--ylen >= 0) && (! y[ylen])) continue;
-  ylen++;
-
-#ifdef DEBUG_SYSTEMC
-  assert(xlen > 1);
-  assert(ylen > 1);
 #endif
 
-  // At this point, all the leading zeros are eliminated from x and y.
-
-  // Zero the last digit of x.
-  x[xlen] = 0;
-
-  // The first two digits of y.
-  sc_digit y2 = (y[ylen - 1] << BITS_PER_BYTE) + y[ylen - 2];
-
-  const sc_digit DOUBLE_BITS_PER_BYTE = 2 * BITS_PER_BYTE;
-
-  // Find each q[k].
-  for (int k = (xlen - ylen); k >= 0; --k) {
-
-    // qk is a guess for q[k] such that q[k] = qk or qk - 1.
-    sc_digit qk;
-
-    // Find qk by just using 2 digits of y and 3 digits of x. The
-    // following code assumes that sizeof(sc_digit) >= 3 BYTEs.
-    int k2 = k + ylen;
-
-    qk = ((x[k2] << DOUBLE_BITS_PER_BYTE) + 
-          (x[k2 - 1] << BITS_PER_BYTE) + x[k2 - 2]) / y2;
-
-    if (qk >= BYTE_RADIX)     // qk cannot be larger than the largest
-      qk = BYTE_RADIX - 1;    // digit in BYTE_RADIX.
-
-    // q[k] = qk or qk - 1. The following if-statement determines which:
-    if (qk) {
-
-      uchar *xk = (x + k);  // A shortcut for x[k].
-
-      // x = x - y * qk :
-      sc_digit carry = 0;
-
-      for (int i = 0; i < ylen; ++i) {
-        carry += y[i] * qk;
-        sc_digit diff = (xk[i] + BYTE_RADIX) - (carry & BYTE_MASK);
-        xk[i] = (uchar)(diff & BYTE_MASK);
-        carry = (carry >> BITS_PER_BYTE) + (1 - (diff >> BITS_PER_BYTE));
-      }
-
-      // If carry, qk may be one too large.
-      if (carry) {
-
-        // 2's complement the last digit.
-        carry = (xk[ylen] + BYTE_RADIX) - carry;
-        xk[ylen] = (uchar)(carry & BYTE_MASK);
-        carry = 1 - (carry >> BITS_PER_BYTE);
-        
-        if (carry) {
-
-          // qk was one too large, so decrement it.
-          --qk;
-        
-          // Since qk was decreased by one, y must be added to x:
-          // That is, x = x - y * (qk - 1) = x - y * qk + y = x_above + y.
-          carry = 0;
-
-          for (int i = 0; i < ylen; ++i) {
-            carry += xk[i] + y[i];
-            xk[i] = (uchar)(carry & BYTE_MASK);
-            carry >>= BITS_PER_BYTE;
-          }
-
-          if (carry)
-            xk[ylen] = (uchar)((xk[ylen] + 1) & BYTE_MASK);
-
-        }  // second if carry
-      }  // first if carry
-    }  // if qk
-
-    q[k] = (uchar)qk;
-
-  }  // for k
-
-  // Set (sc_digit) w = (uchar) q.
-  vec_from_char(xlen - ylen + 1, q, ulen, w);
-
-#ifndef SC_MAX_NBITS
-  delete [] x;
-  delete [] y;
-  delete [] q;
-#endif
+  vec_divrem(ulen, u, vlen, v, w, false);
 
 }
 
@@ -1410,8 +1709,7 @@ vec_div_small(int ulen, const sc_digit *u,
 
 }
 
-// Compute w = u % v, where w, u, and v are vectors. 
-// - u and v are assumed to have at least two digits as uchars.
+// Compute w = u % v, where w, u, and v are vectors.
 void
 vec_rem_large(int ulen, const sc_digit *u,
               int vlen, const sc_digit *v,
@@ -1422,120 +1720,9 @@ vec_rem_large(int ulen, const sc_digit *u,
   assert((ulen > 0) && (u != NULL));
   assert((vlen > 0) && (v != NULL));
   assert(w != NULL);
-  assert(BITS_PER_DIGIT >= 3 * BITS_PER_BYTE);
-#endif
-
-  // This function is adapted from vec_div_large.
-
-  int xlen = BYTES_PER_DIGIT * ulen + 1;
-  int ylen = BYTES_PER_DIGIT * vlen;
-
-#ifdef SC_MAX_NBITS
-  uchar x[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
-  uchar y[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
-#else
-  uchar *x = new uchar[xlen];
-  uchar *y = new uchar[ylen];
 #endif
 
-  // r corresponds to w.
-
-  // Set (uchar) x = (sc_digit) u.
-  xlen = vec_to_char(ulen, u, xlen, x);
-
-  // Skip all the leading zeros in x.
-  while ((--xlen >= 0) && (! x[xlen])) continue;
-  xlen++;
-
-  // Set (uchar) y = (sc_digit) v.
-  ylen = vec_to_char(vlen, v, ylen, y);
-
-  // Skip all the leading zeros in y.
-  while ((--ylen >= 0) && (! y[ylen])) continue;
-  ylen++;
-
-#ifdef DEBUG_SYSTEMC
-  assert(xlen > 1);
-  assert(ylen > 1);
-#endif
-
-  // At this point, all the leading zeros are eliminated from x and y.
-
-  // Zero the last digit of x.
-  x[xlen] = 0;
-
-  // The first two digits of y.
-  sc_digit y2 = (y[ylen - 1] << BITS_PER_BYTE) + y[ylen - 2];
-
-  const sc_digit DOUBLE_BITS_PER_BYTE = 2 * BITS_PER_BYTE;
-
-  // Find each q[k].
-  for (int k = xlen - ylen; k >= 0; --k) {
-
-    // qk is a guess for q[k] such that q[k] = qk or qk - 1.
-    sc_digit qk;
-
-    // Find qk by just using 2 digits of y and 3 digits of x. The
-    // following code assumes that sizeof(sc_digit) >= 3 BYTEs.
-    int k2 = k + ylen;
-
-    qk = ((x[k2] << DOUBLE_BITS_PER_BYTE) +
-      (x[k2 - 1] << BITS_PER_BYTE) + x[k2 - 2]) / y2;
-
-    if (qk >= BYTE_RADIX)     // qk cannot be larger than the largest
-      qk = BYTE_RADIX - 1;    // digit in BYTE_RADIX.
-
-    // q[k] = qk or qk - 1. The following if-statement determines which.
-    if (qk) {
-
-      uchar *xk = (x + k);  // A shortcut for x[k].
-
-      // x = x - y * qk;
-      sc_digit carry = 0;
-
-      for (int i = 0; i < ylen; ++i) {
-        carry += y[i] * qk;
-        sc_digit diff = (xk[i] + BYTE_RADIX) - (carry & BYTE_MASK);
-        xk[i] = (uchar)(diff & BYTE_MASK);
-        carry = (carry >> BITS_PER_BYTE) + (1 - (diff >> BITS_PER_BYTE));
-      }
-
-      if (carry) {
-
-        // 2's complement the last digit.
-        carry = (xk[ylen] + BYTE_RADIX) - carry;
-        xk[ylen] = (uchar)(carry & BYTE_MASK);
-        carry = 1 - (carry >> BITS_PER_BYTE);
-        
-        if (carry) {
-
-          // qk was one too large, so decrement it.
-          // --qk;
-        
-          // x = x - y * (qk - 1) = x - y * qk + y = x_above + y.
-          carry = 0;
-
-          for (int i = 0; i < ylen; ++i) {
-            carry += xk[i] + y[i];
-            xk[i] = (uchar)(carry & BYTE_MASK);
-            carry >>= BITS_PER_BYTE;
-          }
-
-          if (carry)
-            xk[ylen] = (uchar)((xk[ylen] + 1) & BYTE_MASK);
-
-        }  // second if carry
-      } // first if carry
-    }  // if qk
-  }  // for k
-
-  // Set (sc_digit) w = (uchar) x for the remainder.
-  vec_from_char(ylen, x, ulen, w);
-
-#ifndef SC_MAX_NBITS
-  delete [] x;
-  delete [] y;
-#endif
+  vec_divrem(ulen, u, vlen, v, w, true);
 
 }
 
@@ -2154,6 +2154,19 @@ public:
                                      int vnd,
                                      const sc_digit *vd);
 
+protected:
+
+  // Create a number with nb bits on the digits d of a derived class, such
+  // as sc_bigint, which keeps them until after this number is destroyed. If
+  // d is 0, the digits are allocated as usual.
+  sc_signed(int nb, sc_digit *d);
+
+#ifndef SC_MAX_NBITS
+  // Let the derived class destroy the digits given to the constructor.
+  void release_digits()
+    { digit = 0; }
+#endif
+
 private:
 
   small_type  sgn;         // Shortened as s.
@@ -1943,6 +1943,19 @@ public:
 public:
   static sc_core::sc_vpool<sc_unsigned> m_pool;
 
+protected:
+
+  // Create a number with nb bits on the digits d of a derived class, such
+  // as sc_biguint, which keeps them until after this number is destroyed. If
+  // d is 0, the digits are allocated as usual.
+  sc_unsigned(int nb, sc_digit *d);
+
+#ifndef SC_MAX_NBITS
+  // Let the derived class destroy the digits given to the constructor.
+  void release_digits()
+    { digit = 0; }
+#endif
+
 private:
 
   small_type  sgn;         // Shortened as s.
@@ -0,0 +1,219 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_affinity.cpp -- Placement of the simulation threads on the CPUs and NUMA
+                     nodes of the host.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "sysc/kernel/sc_affinity.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  Topology of the host.
+// ----------------------------------------------------------------------------
+
+// parse a cpulist such as "0-15,32-47"
+
+static void
+sc_parse_cpulist( const std::string& list, std::vector<int>& cpus )
+{
+    const char* p = list.c_str();
+    while ( *p )
+    {
+        char* end;
+        long first = strtol( p, &end, 10 );
+        if ( end == p )
+            break;
+        long last = first;
+        p = end;
+        if ( *p == '-' )
+        {
+            last = strtol( p + 1, &end, 10 );
+            p = end;
+        }
+        for ( long cpu = first; cpu <= last; cpu++ )
+            cpus.push_back( (int)cpu );
+        while ( *p == ',' || *p == '\n' || *p == ' ' )
+            p++;
+    }
+}
+
+static bool
+sc_cpu_allowed( int cpu )
+{
+#if defined(__linux__)
+    static cpu_set_t allowed;
+    static bool      known = false;
+    static bool      valid = false;
+    if ( !known )
+    {
+        CPU_ZERO( &allowed );
+        valid = sched_getaffinity( 0, sizeof( allowed ), &allowed ) == 0;
+        known = true;
+    }
+    if ( !valid )
+        return true;
+    return cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET( cpu, &allowed );
+#else
+    return false;
+#endif
+}
+
+static void
+sc_read_topology( std::vector<std::vector<int> >& node_cpus )
+{
+    node_cpus.clear();
+    // node IDs may have holes, so stop only after a run of missing nodes
+    for ( int node = 0, missing = 0; missing < 64; node++ )
+    {
+        char path[64];
+        std::sprintf( path, "/sys/devices/system/node/node%d/cpulist", node );
+        std::ifstream in( path );
+        if ( !in )
+        {
+            missing++;
+            continue;
+        }
+        missing = 0;
+        std::string list;
+        std::getline( in, list );
+        std::vector<int> cpus, allowed;
+        sc_parse_cpulist( list, cpus );
+        for ( unsigned int i = 0; i < cpus.size(); i++ )
+            if ( sc_cpu_allowed( cpus[i] ) )
+                allowed.push_back( cpus[i] );
+        if ( !allowed.empty() )
+            node_cpus.push_back( allowed );
+    }
+    if ( !node_cpus.empty() )
+        return;
+
+    // no NUMA information: all allowed CPUs form one node
+    std::vector<int> cpus;
+#if defined(__linux__)
+    for ( int cpu = 0; cpu < CPU_SETSIZE; cpu++ )
+        if ( sc_cpu_allowed( cpu ) )
+            cpus.push_back( cpu );
+#endif
+    if ( !cpus.empty() )
+        node_cpus.push_back( cpus );
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_affinity
+// ----------------------------------------------------------------------------
+
+sc_affinity::sc_affinity()
+    : m_mode( SC_AFFINITY_NONE ), m_next( 0 )
+{
+    const char* env = std::getenv( _SYSC_AFFINITY_ENV_VAR );
+    if ( env == NULL || *env == 0 || std::strcmp( env, "none" ) == 0 )
+        return;
+    if ( std::strcmp( env, "compact" ) == 0 )
+        m_mode = SC_AFFINITY_COMPACT;
+    else if ( std::strcmp( env, "scatter" ) == 0 )
+        m_mode = SC_AFFINITY_SCATTER;
+    else if ( std::strcmp( env, "module" ) == 0 )
+        m_mode = SC_AFFINITY_MODULE;
+    else
+    {
+        std::cout << "Invalid value of " << _SYSC_AFFINITY_ENV_VAR << ": "
+                  << env << " (compact, scatter, module or none)"
+                  << std::endl;
+        exit(1);
+    }
+
+    sc_read_topology( m_node_cpus );
+    if ( m_node_cpus.empty() )
+    {
+        // the affinity can't be queried on this host
+        m_mode = SC_AFFINITY_NONE;
+        return;
+    }
+
+    if ( m_mode == SC_AFFINITY_COMPACT )
+    {
+        for ( unsigned int n = 0; n < m_node_cpus.size(); n++ )
+            m_order.insert( m_order.end(), m_node_cpus[n].begin(),
+                            m_node_cpus[n].end() );
+    }
+    else
+    {
+        // one CPU of every node in turn; used by MODULE for inst_id < 0
+        for ( unsigned int i = 0, added = 1; added; i++ )
+        {
+            added = 0;
+            for ( unsigned int n = 0; n < m_node_cpus.size(); n++ )
+                if ( i < m_node_cpus[n].size() )
+                {
+                    m_order.push_back( m_node_cpus[n][i] );
+                    added++;
+                }
+        }
+    }
+    m_node_next.assign( m_node_cpus.size(), 0 );
+}
+
+int
+sc_affinity::next_cpu( int inst_id )
+{
+    if ( m_mode == SC_AFFINITY_NONE )
+        return -1;
+    if ( m_mode == SC_AFFINITY_MODULE && inst_id >= 0 )
+    {
+        unsigned int node = (unsigned int)inst_id % m_node_cpus.size();
+        const std::vector<int>& cpus = m_node_cpus[node];
+        return cpus[m_node_next[node]++ % cpus.size()];
+    }
+    return m_order[m_next++ % m_order.size()];
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
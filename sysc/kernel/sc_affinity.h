@@ -0,0 +1,116 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_affinity.h -- Placement of the simulation threads on the CPUs and NUMA
+                   nodes of the host.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_AFFINITY_H
+#define SC_AFFINITY_H
+
+#include <vector>
+
+namespace sc_core {
+
+/**
+ *  \brief Environment variable selecting the placement mode.
+ */
+#ifndef _SYSC_AFFINITY_ENV_VAR
+#define _SYSC_AFFINITY_ENV_VAR "SYSC_AFFINITY"
+#endif
+
+/**
+ *  \brief Placement modes.
+ *
+ *  NONE leaves the threads to the OS. COMPACT fills the CPUs of one NUMA
+ *  node before the next one. SCATTER takes the nodes in turn. MODULE puts
+ *  all processes of the same module instance (the same instance ID) on the
+ *  same node, and takes the CPUs of that node in turn.
+ */
+enum sc_affinity_mode {
+    SC_AFFINITY_NONE = 0,
+    SC_AFFINITY_COMPACT,
+    SC_AFFINITY_SCATTER,
+    SC_AFFINITY_MODULE
+};
+
+/**************************************************************************//**
+ *  \class sc_affinity
+ *
+ *  \brief Chooses the CPU of every simulation thread according to the
+ *         placement mode and the NUMA topology of the host.
+ *
+ *  Only the CPUs the simulator may run on (its own affinity mask) are
+ *  used. The topology is read from /sys/devices/system/node; without it,
+ *  all CPUs form a single node.
+ *****************************************************************************/
+
+class sc_affinity
+{
+public:
+
+    /**
+     *  \brief Read the placement mode from _SYSC_AFFINITY_ENV_VAR and the
+     *         topology of the host.
+     */
+    sc_affinity();
+
+    sc_affinity_mode mode() const { return m_mode; }
+    unsigned int     num_nodes() const { return m_node_cpus.size(); }
+
+    /**
+     *  \brief The CPU for the next thread placed, -1 to leave it unpinned.
+     *         inst_id is only used in MODULE mode (-1 if none).
+     */
+    int next_cpu( int inst_id );
+
+private:
+
+    sc_affinity_mode                m_mode;
+    std::vector<std::vector<int> >  m_node_cpus;    // allowed CPUs per node
+    std::vector<int>                m_order;        // COMPACT/SCATTER order
+    std::vector<unsigned int>       m_node_next;    // MODULE, per node
+    unsigned int                    m_next;         // next in m_order
+
+private:
+
+    // disabled
+    sc_affinity( const sc_affinity& );
+    sc_affinity& operator = ( const sc_affinity& );
+};
+
+} // namespace sc_core
+
+#endif // SC_AFFINITY_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
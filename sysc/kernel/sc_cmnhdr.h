@@ -88,6 +88,15 @@
 #  define SC_UNLIKELY_( x )  __builtin_expect( !!(x), 0 )
 #endif
 
+// ----------------------------------------------------------------------------
+// storage class of per-thread variables of plain (POD) types
+
+#if defined(_MSC_VER)
+#  define SC_THREAD_LOCAL_   __declspec(thread)
+#else
+#  define SC_THREAD_LOCAL_   __thread
+#endif
+
 // ----------------------------------------------------------------------------
 
 #include <cassert>
@@ -126,9 +126,24 @@ public:
      */
     virtual void go( sc_cor* next_cor ) = 0;
 
+    /** 
+     *  \brief Resume the next coroutine and suspend the current one.
+     *
+     *  Same as go( next_cor ) followed by wait( cur_cor ), but a package may
+     *  pass the CPU on directly.
+     */
+    virtual void handoff( sc_cor* cur_cor, sc_cor* next_cor )
+        { go( next_cor ); wait( cur_cor ); }
+
     // abort the current coroutine (and resume the next coroutine)
     virtual void abort( sc_cor* next_cor ) = 0;
 
+    /** 
+     *  \brief Run the coroutine on the given CPU only. A package whose
+     *         coroutines are not OS threads ignores it.
+     */
+    virtual void set_affinity( sc_cor* /* cor */, int /* cpu */ ) {}
+
     // join another coroutine
     virtual void join( sc_cor* join_cor ) = 0;
 
@@ -140,6 +155,13 @@ public:
      */
     virtual void acquire_sched_mutex() = 0;
 
+    /** 
+     *  \brief Acquire the kernel lock only if it is free. A package that
+     *         cannot tell always returns false, and the caller falls back
+     *         to acquire_sched_mutex().
+     */
+    virtual bool try_acquire_sched_mutex() { return false; }
+
     /** 
      *  \brief Release the kernel lock.
      */
@@ -0,0 +1,720 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_cor_pool.cpp -- Coroutine implementation with user-level contexts that
+                     are multiplexed onto a fixed pool of worker pthreads.
+
+  Original Author: Andy Goodrich, Forte Design Systems, 2002-11-10
+                   (sc_cor_pthread.cpp, which this package mirrors)
+
+ CHANGE LOG APPEARS AT THE END OF THE FILE
+ *****************************************************************************/
+
+#if !defined(_WIN32) && !defined(WIN32) && defined(SC_USE_PTHREADS) && \
+    defined(SC_USE_COR_POOL)
+
+// ORDER OF THE INCLUDES AND namespace sc_core IS IMPORTANT!!!
+
+#include "sysc/kernel/sc_cor_pool.h"
+#include "sysc/kernel/sc_constants.h"
+#include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_stack_pool.h"
+#include "sysc/kernel/sc_kernel_ids.h"
+
+#include <unistd.h>
+#include <syscall.h>
+#include <stdint.h>
+
+using namespace std;
+
+namespace sc_core {
+
+// MAKE SURE WE HAVE A NULL THAT WILL WORK:
+
+#if defined(__hpux)
+#   define PTHREAD_NULL cma_c_null
+#else  // !defined(__hpux)
+#   define PTHREAD_NULL NULL
+#endif // !defined(__hpux)
+
+#define DEBUGF \
+    if (0) std::cout << "sc_cor_pool.cpp(" << __LINE__ << ") "
+
+// the number of simulation cores, set by set_number_sim_cpus()
+extern unsigned int _SYSC_NUM_SIM_CPUs;
+
+// ----------------------------------------------------------------------------
+//  File static variables.
+//
+// (1) The ready lists hold the coroutines that were resumed by go() but
+//     have not been picked up by a worker yet: each worker has one for the
+//     coroutines bound to it, and the shared one holds those that never
+//     ran. They are protected by ready_mutex, which is never held together
+//     with sched_mutex in the other order (sched_mutex -> ready_mutex only).
+// (2) The worker key holds the worker that runs on this OS thread, the
+//     coroutine key the coroutine it currently runs. Both are 0 on the main
+//     thread.
+// ----------------------------------------------------------------------------
+
+static sc_cor_pool     main_cor;         // Main coroutine.
+static pthread_mutex_t sched_mutex;      // Kernel scheduling mutex
+static pthread_key_t   thread_key;       // thread-specific data key
+static pthread_key_t   worker_key;       // See note 2 above.
+static pthread_key_t   cor_key;          // See note 2 above.
+static pthread_mutex_t ready_mutex;      // See note 1 above.
+static pthread_cond_t  done_condition;   // signalled when a coroutine ends
+static sc_cor_pool*    ready_head = 0;   // See note 1 above.
+static sc_cor_pool*    ready_tail = 0;   // See note 1 above.
+
+// ----------------------------------------------------------------------------
+//  STRUCT : sc_cor_pool_worker
+//
+//  A worker thread of the pool, and the coroutines bound to it.
+// ----------------------------------------------------------------------------
+
+struct sc_cor_pool_worker
+{
+    sc_cor_pkg_pool* m_pkg_p;       // the package
+    int              m_index;       // index in the workers of the package
+    pthread_t        m_thread;      // the OS thread
+    ucontext_t       m_context;     // saved scheduler context
+    sc_cor_pool*     m_current;     // coroutine running on the worker
+    sc_cor_pool*     m_ready_head;  // ready coroutines bound to the worker
+    sc_cor_pool*     m_ready_tail;
+    pthread_cond_t   m_condition;   // signalled on a new ready entry
+    bool             m_waiting;     // blocked on m_condition
+};
+
+// append a coroutine to a ready list, with ready_mutex held
+
+static void
+push_ready( sc_cor_pool*& head, sc_cor_pool*& tail, sc_cor_pool* cor_p )
+{
+    if ( tail )
+        tail->m_next = cor_p;
+    else
+        head = cor_p;
+    tail = cor_p;
+}
+
+// take the first coroutine of a ready list, with ready_mutex held
+
+static sc_cor_pool*
+pop_ready( sc_cor_pool*& head, sc_cor_pool*& tail )
+{
+    sc_cor_pool* cor_p = head;
+    head = cor_p->m_next;
+    if ( head == 0 )
+        tail = 0;
+    cor_p->m_next = 0;
+    return cor_p;
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_cor_pool
+//
+//  Coroutine class implemented with a user-level context.
+// ----------------------------------------------------------------------------
+
+// constructor
+
+sc_cor_pool::sc_cor_pool()
+    : m_cor_fn( 0 ), m_cor_fn_arg( 0 ), m_specific( 0 ), m_pkg_p( 0 ),
+      m_stack( 0 ), m_stack_size( 0 ), m_state( SUSPENDED ), m_worker( -1 ),
+      m_returned( false ), m_next( 0 ), m_counter( 0 )
+{
+    DEBUGF << this << ": sc_cor_pool::sc_cor_pool()" << std::endl;
+    pthread_cond_init( &m_pt_condition, PTHREAD_NULL );
+}
+
+
+// destructor
+
+sc_cor_pool::~sc_cor_pool()
+{
+    DEBUGF << this << ": sc_cor_pool::~sc_cor_pool()" << std::endl;
+    pthread_cond_destroy( &m_pt_condition );
+    sc_stack_pool::release( m_stack, m_stack_size );
+}
+
+
+// This static method is the entry point of the user-level context and invokes
+// a coroutine for the first time. The coroutine pointer is passed as two
+// 32-bit halves since makecontext() only passes int arguments portably.
+//
+// The worker that dispatched us holds the kernel lock, as a pthread would
+// after returning from its condition wait. We release it before calling the
+// actual sc_cor helper function, like sc_cor_pthread::invoke_module_method.
+
+void sc_cor_pool::invoke_module_method( unsigned int hi, unsigned int lo )
+{
+    sc_cor_pool* p = (sc_cor_pool*)
+        ( ( (uintptr_t)hi << 16 << 16 ) | (uintptr_t)lo );
+    DEBUGF << p << ": sc_cor_pool::invoke_module_method()" << std::endl;
+
+    pthread_mutex_unlock( &sched_mutex );
+
+
+    // CALL THE SYSTEMC CODE THAT WILL ACTUALLY START THE THREAD OFF:
+
+    (p->m_cor_fn)(p->m_cor_fn_arg);
+
+
+    // THE CORE FUNCTION HAS RELEASED THE KERNEL LOCK, RETURN FOR GOOD:
+    //
+    // The worker marks us DONE once it is off our stack, since the
+    // coroutine, and the stack with it, may be deleted from then on.
+
+    p->m_returned = true;
+    sc_cor_pool_worker* worker_p =
+        (sc_cor_pool_worker*)pthread_getspecific( worker_key );
+    setcontext( &worker_p->m_context );
+}
+
+// increment the lock counter
+void sc_cor_pool::increment_counter()
+{
+    m_counter++;
+}
+
+// decrement the lock counter
+void sc_cor_pool::decrement_counter()
+{
+    m_counter--;
+}
+
+// return the lock counter
+unsigned int sc_cor_pool::get_counter()
+{
+    return m_counter;
+}
+
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_cor_pkg_pool
+//
+//  Coroutine package class that runs all coroutines on a fixed pool of
+//  worker pthreads.
+// ----------------------------------------------------------------------------
+
+int sc_cor_pkg_pool::instance_count = 0;
+
+
+// constructor
+
+sc_cor_pkg_pool::sc_cor_pkg_pool( sc_simcontext* simc )
+: sc_cor_pkg( simc ), m_num_workers( 0 ), m_workers( 0 ), m_shutdown( false )
+{
+    // initialize the current coroutine
+    if( ++ instance_count == 1 )
+    {
+        main_cor.m_pkg_p = this;
+        main_cor.m_state = sc_cor_pool::RUNNING;
+        DEBUGF << &main_cor << ": is main co-routine" << std::endl;
+        pthread_mutex_init( &sched_mutex, PTHREAD_NULL );
+        pthread_mutex_init( &ready_mutex, PTHREAD_NULL );
+        pthread_cond_init( &done_condition, PTHREAD_NULL );
+        pthread_key_create( &thread_key, PTHREAD_NULL );
+        pthread_key_create( &worker_key, PTHREAD_NULL );
+        pthread_key_create( &cor_key, PTHREAD_NULL );
+    }
+}
+
+
+// destructor
+
+sc_cor_pkg_pool::~sc_cor_pkg_pool()
+{
+    // STOP THE WORKERS. Coroutines that are still suspended are simply never
+    // resumed again, like the parked pthreads of sc_cor_pkg_pthread. No
+    // coroutine runs any more, so the workers are all on their way to wait
+    // for the next one, and are joined before their state is freed.
+
+    if ( m_workers )
+    {
+        pthread_mutex_lock( &ready_mutex );
+        m_shutdown = true;
+        for ( unsigned int i = 0; i < m_num_workers; i++ )
+            pthread_cond_signal( &m_workers[i].m_condition );
+        pthread_mutex_unlock( &ready_mutex );
+        for ( unsigned int i = 0; i < m_num_workers; i++ )
+        {
+            pthread_join( m_workers[i].m_thread, PTHREAD_NULL );
+            pthread_cond_destroy( &m_workers[i].m_condition );
+        }
+        delete[] m_workers;
+    }
+
+    if( -- instance_count == 0 ) {
+        pthread_cond_destroy( &done_condition );
+        pthread_mutex_destroy( &ready_mutex );
+        pthread_mutex_destroy( &sched_mutex );
+        pthread_key_delete( thread_key );
+        pthread_key_delete( worker_key );
+        pthread_key_delete( cor_key );
+    }
+}
+
+
+// create a new coroutine
+//
+// Only the descriptor is set up here. No OS thread is created, and the stack
+// and the context are set up by the worker that runs the coroutine first
+// (see make_context).
+
+sc_cor*
+sc_cor_pkg_pool::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
+{
+    sc_cor_pool* cor_p = new sc_cor_pool;
+    DEBUGF << &main_cor << ": sc_cor_pkg_pool::create("
+           << cor_p << ")" << std::endl;
+
+
+    // INITIALIZE OBJECT'S FIELDS FROM ARGUMENT LIST:
+
+    cor_p->m_pkg_p = this;
+    cor_p->m_cor_fn = fn;
+    cor_p->m_cor_fn_arg = arg;
+    cor_p->m_specific = arg;
+    cor_p->m_stack_size = stack_size ? stack_size : SC_DEFAULT_STACK_SIZE;
+
+    return cor_p;
+}
+
+
+// set up the stack and the context of a coroutine that runs for the first
+// time, to start in invoke_module_method
+
+static void
+make_context( sc_cor_pool* cor_p )
+{
+    cor_p->m_stack = sc_stack_pool::allocate( cor_p->m_stack_size );
+    if ( cor_p->m_stack == 0 )
+        SC_REPORT_FATAL( SC_ID_COR_STACK_ALLOC_, 0 );
+
+    uintptr_t cor_bits = (uintptr_t)cor_p;
+    getcontext( &cor_p->m_context );
+    cor_p->m_context.uc_stack.ss_sp = cor_p->m_stack;
+    cor_p->m_context.uc_stack.ss_size = cor_p->m_stack_size;
+    cor_p->m_context.uc_link = 0;
+    makecontext( &cor_p->m_context,
+                 (void (*)())&sc_cor_pool::invoke_module_method, 2,
+                 (unsigned int)( cor_bits >> 16 >> 16 ),
+                 (unsigned int)( cor_bits & 0xffffffffu ) );
+}
+
+
+// start the worker threads
+//
+// The number of workers is the number of simulation cores, which is not
+// known before sc_start() reads SYSC_PAR_SIM_CPUS, so we start them lazily.
+// m_num_workers counts the workers actually created: the simulation goes on
+// with fewer workers if some cannot be created, and stops without any.
+
+void
+sc_cor_pkg_pool::start_workers()
+{
+    unsigned int num_workers = _SYSC_NUM_SIM_CPUs ? _SYSC_NUM_SIM_CPUs : 1;
+    m_workers = new sc_cor_pool_worker[num_workers];
+    for ( ; m_num_workers < num_workers; m_num_workers++ )
+    {
+        sc_cor_pool_worker* worker_p = &m_workers[m_num_workers];
+        worker_p->m_pkg_p = this;
+        worker_p->m_index = m_num_workers;
+        worker_p->m_current = 0;
+        worker_p->m_ready_head = 0;
+        worker_p->m_ready_tail = 0;
+        worker_p->m_waiting = false;
+        pthread_cond_init( &worker_p->m_condition, PTHREAD_NULL );
+        if ( pthread_create( &worker_p->m_thread, PTHREAD_NULL,
+                             &sc_cor_pkg_pool::worker_loop, (void*)worker_p ) )
+        {
+            pthread_cond_destroy( &worker_p->m_condition );
+            break;
+        }
+    }
+
+    if ( m_num_workers == 0 )
+        SC_REPORT_FATAL( SC_ID_COR_POOL_WORKER_, 0 );
+    else if ( m_num_workers < num_workers )
+        SC_REPORT_WARNING( SC_ID_COR_POOL_WORKER_, 0 );
+}
+
+
+// body of a worker thread
+//
+// A worker takes the next coroutine bound to it, or else the next one that
+// never ran and binds it, acquires the kernel lock on its behalf (the
+// coroutine resumes from wait() holding it) and switches to it. When the
+// coroutine suspends again it switches back here still holding the kernel
+// lock, which the worker then releases. This keeps the lock owned by the OS
+// thread that acquired it. The coroutine that comes back may be another one
+// of this worker, if the first one handed off to it.
+
+void*
+sc_cor_pkg_pool::worker_loop( void* worker_arg_p )
+{
+    sc_cor_pool_worker* worker_p = (sc_cor_pool_worker*)worker_arg_p;
+    sc_cor_pkg_pool*    pkg = worker_p->m_pkg_p;
+
+    pthread_setspecific( worker_key, worker_p );
+
+    for ( ;; )
+    {
+        sc_cor_pool* cor_p = 0;
+        pthread_mutex_lock( &ready_mutex );
+        while ( cor_p == 0 )
+        {
+            if ( worker_p->m_ready_head )
+            {
+                cor_p = pop_ready( worker_p->m_ready_head,
+                                   worker_p->m_ready_tail );
+            }
+            else if ( ready_head )
+            {
+                cor_p = pop_ready( ready_head, ready_tail );
+                cor_p->m_worker = worker_p->m_index;
+            }
+            else if ( pkg->m_shutdown )
+            {
+                break;
+            }
+            else
+            {
+                worker_p->m_waiting = true;
+                pthread_cond_wait( &worker_p->m_condition, &ready_mutex );
+                worker_p->m_waiting = false;
+            }
+        }
+        pthread_mutex_unlock( &ready_mutex );
+        if ( cor_p == 0 ) // shutdown
+            break;
+
+        if ( cor_p->m_stack == 0 )
+            make_context( cor_p );
+
+        pthread_mutex_lock( &sched_mutex );
+        cor_p->m_state = sc_cor_pool::RUNNING;
+        worker_p->m_current = cor_p;
+        pthread_setspecific( cor_key, cor_p );
+        pthread_setspecific( thread_key, cor_p->m_specific );
+
+        swapcontext( &worker_p->m_context, &cor_p->m_context );
+
+        // back on the worker: either suspended in wait() with the kernel
+        // lock held, or returned with the kernel lock already released
+        cor_p = worker_p->m_current;
+        worker_p->m_current = 0;
+        pthread_setspecific( cor_key, 0 );
+        pthread_setspecific( thread_key, 0 );
+        if ( cor_p->m_returned )
+        {
+            pthread_mutex_lock( &ready_mutex );
+            cor_p->m_state = sc_cor_pool::DONE;
+            pthread_cond_broadcast( &done_condition );
+            pthread_mutex_unlock( &ready_mutex );
+        }
+        else
+        {
+            pthread_mutex_unlock( &sched_mutex );
+        }
+    }
+
+    return 0;
+}
+
+
+// yield to the next coroutine
+
+void
+sc_cor_pkg_pool::yield( sc_cor* next_cor_p )
+{
+    sc_cor_pool* from_p = (sc_cor_pool*)pthread_getspecific( cor_key );
+
+    go( next_cor_p );
+    wait( from_p ? (sc_cor*)from_p : (sc_cor*)&main_cor );
+}
+
+
+// suspend the current coroutine
+
+void
+sc_cor_pkg_pool::wait( sc_cor* cur_cor_p )
+{
+    sc_cor_pool* from_p = (sc_cor_pool*)cur_cor_p;
+
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+    from_p->m_state = sc_cor_pool::SUSPENDED;
+    if ( from_p == &main_cor )
+    {
+        while ( from_p->m_state != sc_cor_pool::RUNNING )
+            pthread_cond_wait( &from_p->m_pt_condition, &sched_mutex );
+    }
+    else
+    {
+        // the coroutine may resume on another worker, so save the value the
+        // thread specific data has for it and look up the worker afresh
+        from_p->m_specific = pthread_getspecific( thread_key );
+        sc_cor_pool_worker* worker_p =
+            (sc_cor_pool_worker*)pthread_getspecific( worker_key );
+        swapcontext( &from_p->m_context, &worker_p->m_context );
+    }
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+}
+
+
+// resume the next coroutine
+//
+// As with a condition signal in the pthread package, resuming a coroutine
+// that is not suspended has no effect.
+
+void
+sc_cor_pkg_pool::go( sc_cor* next_cor_p )
+{
+    sc_cor_pool* to_p = (sc_cor_pool*)next_cor_p;
+
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+    if ( to_p->m_state != sc_cor_pool::SUSPENDED )
+        return;
+
+    if ( to_p == &main_cor )
+    {
+        to_p->m_state = sc_cor_pool::RUNNING;
+        pthread_cond_signal( &to_p->m_pt_condition );
+        return;
+    }
+
+    if ( !m_workers )
+        start_workers();
+
+    // a coroutine that ran before goes back to its worker, one that never
+    // ran to the first worker that is free
+    to_p->m_state = sc_cor_pool::QUEUED;
+    pthread_mutex_lock( &ready_mutex );
+    if ( to_p->m_worker >= 0 )
+    {
+        sc_cor_pool_worker* worker_p = &m_workers[to_p->m_worker];
+        push_ready( worker_p->m_ready_head, worker_p->m_ready_tail, to_p );
+        pthread_cond_signal( &worker_p->m_condition );
+    }
+    else
+    {
+        push_ready( ready_head, ready_tail, to_p );
+        for ( unsigned int i = 0; i < m_num_workers; i++ )
+        {
+            if ( m_workers[i].m_waiting )
+            {
+                pthread_cond_signal( &m_workers[i].m_condition );
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock( &ready_mutex );
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+}
+
+
+// resume the next coroutine and suspend the current one
+//
+// If the next coroutine may run on this worker, the worker switches to it
+// right away, with the kernel lock still held, instead of queueing it and
+// picking it up again after the current coroutine switched back.
+
+void
+sc_cor_pkg_pool::handoff( sc_cor* cur_cor_p, sc_cor* next_cor_p )
+{
+    sc_cor_pool*        from_p = (sc_cor_pool*)cur_cor_p;
+    sc_cor_pool*        to_p = (sc_cor_pool*)next_cor_p;
+    sc_cor_pool_worker* worker_p =
+        (sc_cor_pool_worker*)pthread_getspecific( worker_key );
+
+    if ( worker_p == 0 || from_p == &main_cor || to_p == &main_cor ||
+         to_p->m_state != sc_cor_pool::SUSPENDED ||
+         ( to_p->m_worker >= 0 && to_p->m_worker != worker_p->m_index ) )
+    {
+        go( next_cor_p );
+        wait( cur_cor_p );
+        return;
+    }
+
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+    from_p->m_state = sc_cor_pool::SUSPENDED;
+    from_p->m_specific = pthread_getspecific( thread_key );
+
+    to_p->m_worker = worker_p->m_index;
+    if ( to_p->m_stack == 0 )
+        make_context( to_p );
+    to_p->m_state = sc_cor_pool::RUNNING;
+    worker_p->m_current = to_p;
+    pthread_setspecific( cor_key, to_p );
+    pthread_setspecific( thread_key, to_p->m_specific );
+
+    swapcontext( &from_p->m_context, &to_p->m_context );
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+}
+
+
+// abort the current coroutine (and resume the next coroutine)
+
+void
+sc_cor_pkg_pool::abort( sc_cor* next_cor_p )
+{
+    go( next_cor_p );
+}
+
+// set the affinity of a coroutine
+
+void
+sc_cor_pkg_pool::set_affinity( sc_cor* /* cor_p */, int /* cpu */ )
+{
+    static bool warned = false;
+    if ( !warned )
+    {
+        warned = true;
+        SC_REPORT_WARNING( SC_ID_COR_POOL_AFFINITY_, 0 );
+    }
+}
+
+
+// join another coroutine
+
+void
+sc_cor_pkg_pool::join( sc_cor* join_cor_p )
+{
+    sc_cor_pool* join_p = (sc_cor_pool*)join_cor_p;
+
+    pthread_mutex_lock( &ready_mutex );
+    while ( join_p->m_state != sc_cor_pool::DONE )
+        pthread_cond_wait( &done_condition, &ready_mutex );
+    pthread_mutex_unlock( &ready_mutex );
+}
+
+
+// get the main coroutine
+
+sc_cor*
+sc_cor_pkg_pool::get_main()
+{
+    return &main_cor;
+}
+
+
+// acquire the kernel lock
+
+void
+sc_cor_pkg_pool::acquire_sched_mutex()
+{
+#ifdef SC_LOCK_CHECK
+    assert( is_not_owner() );
+#endif /* SC_LOCK_CHECK */
+    pthread_mutex_lock( &sched_mutex );
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+}
+
+
+// release the kernel lock
+
+void
+sc_cor_pkg_pool::release_sched_mutex()
+{
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+    pthread_mutex_unlock( &sched_mutex );
+#ifdef SC_LOCK_CHECK
+    assert( is_not_owner() );
+#endif /* SC_LOCK_CHECK */
+}
+
+
+// set the thread specific data value
+
+void
+sc_cor_pkg_pool::set_thread_specific( void* process_b )
+{
+    pthread_setspecific( thread_key, process_b );
+}
+
+
+// get the thread specific data value
+
+void*
+sc_cor_pkg_pool::get_thread_specific()
+{
+    return pthread_getspecific( thread_key );
+}
+
+
+// get the state of the kernel lock
+
+bool
+sc_cor_pkg_pool::is_locked()
+{
+    return ( sched_mutex.__data.__lock > 0 );
+}
+
+
+bool
+sc_cor_pkg_pool::is_unlocked()
+{
+    return ( sched_mutex.__data.__lock == 0 );
+}
+
+
+bool
+sc_cor_pkg_pool::is_lock_owner()
+{
+    return ( sched_mutex.__data.__owner == syscall(SYS_gettid) );
+}
+
+
+bool
+sc_cor_pkg_pool::is_not_owner()
+{
+    return ( sched_mutex.__data.__owner != syscall(SYS_gettid) );
+}
+
+
+bool
+sc_cor_pkg_pool::is_locked_and_owner()
+{
+    return ( sched_mutex.__data.__lock > 0 && sched_mutex.__data.__owner == syscall(SYS_gettid) );
+}
+
+
+} // namespace sc_core
+
+#endif // !defined(_WIN32) && !defined(WIN32) && defined(SC_USE_PTHREADS) &&
+       // defined(SC_USE_COR_POOL)
+
+// Taf!
@@ -0,0 +1,267 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_cor_pool.h -- Coroutine implementation with user-level contexts that are
+                   multiplexed onto a fixed pool of worker pthreads.
+
+  Original Author: Andy Goodrich, Forte Design Systems, 2002-11-10
+                   (sc_cor_pthread.h, which this package mirrors)
+
+ CHANGE LOG APPEARS AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_COR_POOL_H
+#define SC_COR_POOL_H
+
+
+#if defined(SC_USE_PTHREADS) && defined(SC_USE_COR_POOL)
+
+#include "sysc/kernel/sc_cor.h"
+#include "sysc/kernel/sc_cmnhdr.h"
+#include <pthread.h>
+#include <ucontext.h>
+
+namespace sc_core {
+
+class sc_cor_pkg_pool;
+typedef sc_cor_pkg_pool sc_cor_pkg_t;
+
+struct sc_cor_pool_worker;
+
+/**************************************************************************//**
+ *  \class sc_cor_pool
+ *
+ *  \brief Coroutine class implemented with a user-level context.
+ *
+ * Notes:
+ *   (1) A coroutine does not own an OS thread. It is bound to the worker
+ *       thread of the package that runs it first, and is always resumed by
+ *       that worker. Per-thread state (the __thread pools of the
+ *       temporaries, the fixed-point free lists and the deferred event
+ *       updates) must not change under a coroutine, since the compiler may
+ *       keep the address of such a variable across a wait().
+ *   (2) The main coroutine is the only exception: it stays on the OS thread
+ *       that runs sc_main and is suspended on m_pt_condition, exactly as in
+ *       the pthread package.
+ *   (3) The stack and the context are set up by the worker that runs the
+ *       coroutine for the first time, so processes that never run cost no
+ *       stack. Stacks come from sc_stack_pool and go back there when the
+ *       coroutine is deleted.
+ *****************************************************************************/
+
+class sc_cor_pool : public sc_cor
+{
+  public:
+
+    // states of a coroutine (see sc_cor_pkg_pool::go and ::wait)
+    enum cor_state {
+        SUSPENDED = 0, // waiting for go(), initial state
+        QUEUED,        // in the ready list of the package
+        RUNNING,       // executing on a worker (or on the main thread)
+        DONE           // the core function returned
+    };
+
+    // constructor
+    sc_cor_pool();
+
+    // destructor
+    virtual ~sc_cor_pool();
+
+    // module method invocator (starts coroutine execution)
+    static void invoke_module_method( unsigned int hi, unsigned int lo );
+
+    /**
+     *  \brief Increment the lock counter.
+     */
+    virtual void increment_counter();
+
+    /**
+     *  \brief Decrement the lock counter.
+     */
+    virtual void decrement_counter();
+
+    /**
+     *  \brief Get the value of the lock counter.
+     */
+    virtual unsigned int get_counter();
+
+  public:
+    sc_cor_fn*          m_cor_fn;	// Core function.
+    void*               m_cor_fn_arg;	// Core function argument.
+    void*               m_specific;     // Thread specific data value.
+
+    sc_cor_pkg_pool*    m_pkg_p;        // the creating coroutine package
+    ucontext_t          m_context;      // saved user-level context
+    char*               m_stack;        // stack of the context
+    std::size_t         m_stack_size;   // size of m_stack
+    cor_state           m_state;        // see cor_state
+    int                 m_worker;       // worker it is bound to, -1 before
+                                        // its first run
+    bool                m_returned;     // core function returned, set
+                                        // before the switch to the worker
+    sc_cor_pool*        m_next;         // next coroutine in the ready list
+    pthread_cond_t      m_pt_condition; // Condition the main coroutine
+                                        // waits for.
+
+    /**
+     *  \brief The counter tracking the lock attempts of the kernel lock.
+     */
+    unsigned int        m_counter;
+
+private:
+
+    // disabled
+    sc_cor_pool( const sc_cor_pool& );
+    sc_cor_pool& operator = ( const sc_cor_pool& );
+};
+
+
+/**************************************************************************//**
+ *  \class sc_cor_pkg_pool
+ *
+ *  \brief Coroutine package class that runs all coroutines on a fixed pool
+ *         of SYSC_PAR_SIM_CPUS worker pthreads.
+ *****************************************************************************/
+
+class sc_cor_pkg_pool
+: public sc_cor_pkg
+{
+public:
+
+    // constructor
+    sc_cor_pkg_pool( sc_simcontext* simc );
+
+    // destructor
+    virtual ~sc_cor_pkg_pool();
+
+    // create a new coroutine
+    virtual sc_cor* create( std::size_t stack_size, sc_cor_fn* fn, void* arg );
+
+    // yield to the next coroutine
+    virtual void yield( sc_cor* next_cor );
+
+    /**
+     *  \brief Suspend the current coroutine.
+     */
+    virtual void wait( sc_cor* cur_cor );
+
+    /**
+     *  \brief Resume the next coroutine.
+     */
+    virtual void go( sc_cor* next_cor );
+
+    /**
+     *  \brief Resume the next coroutine and suspend the current one. The
+     *         worker switches to the next coroutine directly if it is bound
+     *         to this worker, or not bound yet.
+     */
+    virtual void handoff( sc_cor* cur_cor, sc_cor* next_cor );
+
+    // abort the current coroutine (and resume the next coroutine)
+    virtual void abort( sc_cor* next_cor );
+
+    /**
+     *  \brief Coroutines run on the workers they are bound to, which are not
+     *         pinned, so this only warns once that SYSC_AFFINITY is ignored.
+     */
+    virtual void set_affinity( sc_cor* cor, int cpu );
+
+    // join another coroutine
+    virtual void join( sc_cor* join_cor );
+
+    // get the main coroutine
+    virtual sc_cor* get_main();
+
+    /**
+     *  \brief Acquire the kernel lock.
+     */
+    virtual void acquire_sched_mutex();
+
+    /**
+     *  \brief Release the kernel lock.
+     */
+    virtual void release_sched_mutex();
+
+    /**
+     *  \brief Set the thread specific data value.
+     */
+    virtual void set_thread_specific( void* process_b );
+
+    /**
+     *  \brief Get the thread specific data value.
+     */
+    virtual void* get_thread_specific();
+
+    /**
+     *  \brief Check whether the kernel lock is acquired.
+     */
+    virtual bool is_locked();
+
+    /**
+     *  \brief Check whether the kernel lock is released.
+     */
+    virtual bool is_unlocked();
+
+    /**
+     *  \brief Check whether the kernel lock is owned by this coroutine.
+     */
+    virtual bool is_lock_owner();
+
+    /**
+     *  \brief Check whether the kernel lock is not owned by this coroutine.
+     */
+    virtual bool is_not_owner();
+
+    /**
+     *  \brief Check whether the kernel lock is acquired and owned by this
+     *         coroutine.
+     */
+    virtual bool is_locked_and_owner();
+
+private:
+
+    // start the worker threads (on the first go())
+    void start_workers();
+
+    // body of a worker thread
+    static void* worker_loop( void* pkg_p );
+
+private:
+
+    static int instance_count;
+
+    unsigned int        m_num_workers;  // number of worker threads
+    sc_cor_pool_worker* m_workers;      // the worker threads
+    bool                m_shutdown;     // tells the workers to exit
+
+private:
+
+    // disabled
+    sc_cor_pkg_pool();
+    sc_cor_pkg_pool( const sc_cor_pkg_pool& );
+    sc_cor_pkg_pool& operator = ( const sc_cor_pkg_pool& );
+};
+
+} // namespace sc_core
+
+#endif // defined(SC_USE_PTHREADS) && defined(SC_USE_COR_POOL)
+
+#endif // SC_COR_POOL_H
+
+// Taf!
@@ -30,9 +30,13 @@
 
 #include "sysc/kernel/sc_cor_pthread.h"
 #include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_stack_pool.h"
+#include "sysc/utils/sc_temporary.h"
 
+#include <limits.h>
 #include <unistd.h>
 #include <syscall.h>
+#include <linux/futex.h>
 
 using namespace std;
 
@@ -51,20 +55,42 @@ namespace sc_core {
 
 // ----------------------------------------------------------------------------
 //  File static variables.
-//
-// (1) The thread creation mutex and the creation condition are used to
-//     suspend the thread creating another one until the created thread
-//     reaches its invoke_module_method. This allows us to get control of
-//     thread scheduling away from the pthread package.
 // ----------------------------------------------------------------------------
 
 //static sc_cor_pthread* active_cor_p=0;   // Active co-routine.
-static pthread_cond_t  create_condition; // See note 1 above.
-static pthread_mutex_t create_mutex;     // See note 1 above.
 static sc_cor_pthread  main_cor;         // Main coroutine.
 static pthread_mutex_t sched_mutex;      // Kernel scheduling mutex
 static pthread_key_t thread_key;         // thread-specific data key
 
+// values of sc_cor_pthread::m_resume besides 0
+
+enum { SC_COR_RESUMED = 1, SC_COR_SLEEPING = 2 };
+
+// block the calling thread until resume_cor() is called on word
+
+static void
+block_cor( int* word )
+{
+    int expected = 0;
+    if ( !__atomic_compare_exchange_n( word, &expected, SC_COR_SLEEPING,
+                                       false, __ATOMIC_ACQUIRE,
+                                       __ATOMIC_ACQUIRE ) )
+        return; // resumed already
+    while ( __atomic_load_n( word, __ATOMIC_ACQUIRE ) == SC_COR_SLEEPING )
+        syscall( SYS_futex, word, FUTEX_WAIT_PRIVATE, SC_COR_SLEEPING,
+                 NULL, NULL, 0 );
+}
+
+// resume the thread blocked (or about to block) on word
+
+static void
+resume_cor( int* word )
+{
+    if ( __atomic_exchange_n( word, SC_COR_RESUMED, __ATOMIC_RELEASE ) ==
+         SC_COR_SLEEPING )
+        syscall( SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+}
+
 // ----------------------------------------------------------------------------
 //  CLASS : sc_cor_pthread
 //
@@ -74,7 +100,9 @@ static pthread_key_t thread_key;         // thread-specific data key
 // constructor
 
 sc_cor_pthread::sc_cor_pthread()
-    : m_cor_fn_arg( 0 ), m_pkg_p( 0 ), m_counter( 0 )
+    : m_cor_fn_arg( 0 ), m_pkg_p( 0 ), m_resume( 0 ), m_counter( 0 ),
+      m_stack_size( 0 ), m_stack( 0 ), m_cpu( -1 ), m_started( false ),
+      m_done( 0 )
 {
     DEBUGF << this << ": sc_cor_pthread::sc_cor_pthread()" << std::endl;
     pthread_cond_init( &m_pt_condition, PTHREAD_NULL );
@@ -87,14 +115,22 @@ sc_cor_pthread::sc_cor_pthread()
 sc_cor_pthread::~sc_cor_pthread()
 {
     DEBUGF << this << ": sc_cor_pthread::~sc_cor_pthread()" << std::endl;
+
+    // a thread still suspended in its core function keeps its stack; one
+    // that returned is reaped, and its stack is reused
+    if ( m_started && __atomic_load_n( &m_done, __ATOMIC_ACQUIRE ) &&
+         pthread_join( m_thread, NULL ) == 0 )
+        sc_stack_pool::release( m_stack, m_stack_size );
+
     pthread_cond_destroy( &m_pt_condition);
     pthread_mutex_destroy( &m_mutex );
 }
 
 
 // This static method is a Posix Threads helper callback and invokes a thread
-// for the first time. It performs some synchronization and then invokes the
-// actual sc_cor helper function.
+// for the first time. The thread is created by the first resume of the
+// coroutine (see sc_cor_pkg_pthread::start), so it runs the actual sc_cor
+// helper function at once.
 //     context_p -> thread to invoke module method of.
 // Result is 0 and ignored.
 
@@ -103,35 +139,12 @@ void* sc_cor_pthread::invoke_module_method(void* context_p)
     sc_cor_pthread* p = (sc_cor_pthread*)context_p;
     DEBUGF << p << ": sc_cor_pthread::invoke_module_method()" << std::endl;
 
-
-    // SUSPEND THE THREAD SO WE CAN GAIN CONTROL FROM THE PTHREAD PACKAGE:
-    //
-    // Since pthread_create schedules each thread behind our back for its
-    // initial execution we immediately suspend a newly created thread
-    // here so we can control when its execution will occur. We also wake
-    // up the main thread which is waiting for this thread to execute to this
-    // wait point.
-
-    pthread_mutex_lock( &create_mutex );
-
     // m_cor_fn_arg is a pointer to sc_thread_process or sc_method_process
     pthread_setspecific( thread_key, p->m_cor_fn_arg ); 
 
-    DEBUGF << p << ": child signalling main thread " << endl;
-    pthread_cond_signal( &create_condition );
-    pthread_mutex_lock( &sched_mutex );
-    pthread_mutex_unlock( &create_mutex );
-    pthread_cond_wait( &p->m_pt_condition, &sched_mutex );
-    pthread_mutex_unlock( &sched_mutex );
-
-
-    // CALL THE SYSTEMC CODE THAT WILL ACTUALLY START THE THREAD OFF:
-
-//    active_cor_p = p;
-//    DEBUGF << p << ": about to invoke real method " 
-//	   << active_cor_p << std::endl;
     (p->m_cor_fn)(p->m_cor_fn_arg);
 
+    __atomic_store_n( &p->m_done, 1, __ATOMIC_RELEASE );
     return 0;
 }
 
@@ -171,10 +184,9 @@ sc_cor_pkg_pthread::sc_cor_pkg_pthread( sc_simcontext* simc )
     // initialize the current coroutine
     if( ++ instance_count == 1 )
     {
-        pthread_cond_init( &create_condition, PTHREAD_NULL );
-        pthread_mutex_init( &create_mutex, PTHREAD_NULL );
 //        assert( active_cor_p == 0 );
         main_cor.m_pkg_p = this;
+        main_cor.m_started = true;
         DEBUGF << &main_cor << ": is main co-routine" << std::endl;
 //        active_cor_p = &main_cor;
         pthread_mutex_init( &sched_mutex, PTHREAD_NULL );
@@ -189,9 +201,6 @@ sc_cor_pkg_pthread::~sc_cor_pkg_pthread()
 {
     if( -- instance_count == 0 ) {
         // cleanup the main coroutine
-        // 10/14/2014 GL: destroy create_condition & create_mutex
-        pthread_cond_destroy( &create_condition );
-        pthread_mutex_destroy( &create_mutex );
         pthread_mutex_destroy( &sched_mutex );
         pthread_key_delete( thread_key );
     }
@@ -199,6 +208,9 @@ sc_cor_pkg_pthread::~sc_cor_pkg_pthread()
 
 
 // create a new coroutine
+//
+// Only the descriptor is set up here; the thread is created by the first
+// resume of the coroutine.
 
 sc_cor*
 sc_cor_pkg_pthread::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
@@ -207,59 +219,79 @@ sc_cor_pkg_pthread::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
     DEBUGF << &main_cor << ": sc_cor_pkg_pthread::create(" 
            << cor_p << ")" << std::endl;
 
-
-    // INITIALIZE OBJECT'S FIELDS FROM ARGUMENT LIST:
-
     cor_p->m_pkg_p = this;
     cor_p->m_cor_fn = fn;
     cor_p->m_cor_fn_arg = arg;
+    cor_p->m_stack_size = stack_size;
+
+    return cor_p;
+}
 
 
-    // SET UP THREAD CREATION ATTRIBUTES:
-    //
-    // Use default values except for stack size. If stack size is non-zero
-    // set it.
+// create the thread of a coroutine
+//
+// The thread finds itself resumed already (m_resume), so it runs its core
+// function at once and returns from its first wait() only when resumed
+// again. A stack from the pool is used where possible; otherwise the pthread
+// package allocates one as before.
 
+void
+sc_cor_pkg_pthread::start( sc_cor_pthread* cor_p )
+{
     pthread_attr_t attr;
     pthread_attr_init( &attr ); 
-    if ( stack_size != 0 )
+
+    std::size_t size = cor_p->m_stack_size;
+    if ( size == 0 )
+        pthread_attr_getstacksize( &attr, &size );
+    if ( size < (std::size_t)PTHREAD_STACK_MIN )
+        size = PTHREAD_STACK_MIN;
+    cor_p->m_stack = sc_stack_pool::allocate( size );
+    if ( cor_p->m_stack != 0 )
     {
-        pthread_attr_setstacksize( &attr, stack_size );
+        cor_p->m_stack_size = size;
+        pthread_attr_setstack( &attr, cor_p->m_stack, size );
+    }
+    else if ( cor_p->m_stack_size != 0 )
+    {
+        pthread_attr_setstacksize( &attr, cor_p->m_stack_size );
     }
 
+#if defined(__linux__)
+    if ( cor_p->m_cpu >= 0 )
+    {
+        cpu_set_t cpus;
+        CPU_ZERO( &cpus );
+        CPU_SET( cor_p->m_cpu, &cpus );
+        pthread_attr_setaffinity_np( &attr, sizeof( cpus ), &cpus );
+    }
+#endif
 
-    // ALLOCATE THE POSIX THREAD TO USE AND FORCE SEQUENTIAL EXECUTION:
-    //
-    // Because pthread_create causes the created thread to be executed,
-    // we need to let it run until we can block in the invoke_module_method.
-    // So we:
-    //   (1) Lock the creation mutex before creating the new thread.
-    //   (2) Sleep on the creation condition, which will be signalled by
-    //       the newly created thread just before it goes to sleep in
-    //       invoke_module_method.
-    // This scheme results in the newly created thread being dormant before
-    // the main thread continues execution.
-
-    pthread_mutex_lock( &create_mutex );
+    __atomic_store_n( &cor_p->m_resume, SC_COR_RESUMED, __ATOMIC_RELAXED );
+    cor_p->m_started = true;
     DEBUGF << &main_cor << ": about to create actual thread " 
            << cor_p << std::endl;
     if ( pthread_create( &cor_p->m_thread, &attr,
              &sc_cor_pthread::invoke_module_method, (void*)cor_p ) )
     {
         std::fprintf(stderr, "ERROR - could not create thread\n");
+        cor_p->m_started = false;
+        sc_stack_pool::release( cor_p->m_stack, cor_p->m_stack_size );
+        cor_p->m_stack = 0;
     }
-
-    DEBUGF << &main_cor << ": main thread waiting for signal from " 
-           << cor_p << std::endl;
-    pthread_cond_wait( &create_condition, &create_mutex );
-    DEBUGF << &main_cor << ": main thread signaled by " 
-           << cor_p << endl;
     pthread_attr_destroy( &attr ); 
-    pthread_mutex_unlock( &create_mutex );
-    DEBUGF << &main_cor << ": exiting sc_cor_pkg_pthread::create(" 
-           << cor_p << ")" << std::endl;
+}
 
-    return cor_p;
+
+// resume a coroutine, starting its thread if it has none yet
+
+void
+sc_cor_pkg_pthread::resume( sc_cor_pthread* cor_p )
+{
+    if ( cor_p->m_started )
+        resume_cor( &cor_p->m_resume );
+    else
+        start( cor_p );
 }
 
 
@@ -299,7 +331,11 @@ sc_cor_pkg_pthread::wait( sc_cor* cur_cor_p )
 #ifdef SC_LOCK_CHECK
     assert( is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
-    pthread_cond_wait( &from_p->m_pt_condition, &sched_mutex );
+    __atomic_store_n( &from_p->m_resume, 0, __ATOMIC_RELAXED );
+    pthread_mutex_unlock( &sched_mutex );
+    sc_temp_release(); // the temporaries go to the next running thread
+    block_cor( &from_p->m_resume );
+    pthread_mutex_lock( &sched_mutex );
 #ifdef SC_LOCK_CHECK
     assert( is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
@@ -315,13 +351,63 @@ sc_cor_pkg_pthread::go( sc_cor* next_cor_p )
 #ifdef SC_LOCK_CHECK
     assert( is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
-    pthread_cond_signal( &to_p->m_pt_condition );
+    resume( to_p );
 #ifdef SC_LOCK_CHECK
     assert( is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
 }
 
 
+// resume the next coroutine and suspend the current one
+//
+// The kernel lock is released before the next coroutine is woken up, so it
+// does not have to sleep a second time on the lock. This is safe because the
+// current coroutine is marked as suspended (m_resume = 0) while the lock is
+// still held, so a go() from any other thread after that is not lost.
+
+void
+sc_cor_pkg_pthread::handoff( sc_cor* cur_cor_p, sc_cor* next_cor_p )
+{
+    sc_cor_pthread* from_p = (sc_cor_pthread*)cur_cor_p;
+    sc_cor_pthread* to_p = (sc_cor_pthread*)next_cor_p;
+
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+    __atomic_store_n( &from_p->m_resume, 0, __ATOMIC_RELAXED );
+    pthread_mutex_unlock( &sched_mutex );
+    sc_temp_release();
+    resume( to_p );
+    block_cor( &from_p->m_resume );
+    pthread_mutex_lock( &sched_mutex );
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+}
+
+
+// pin the thread of the coroutine to the given CPU
+
+void
+sc_cor_pkg_pthread::set_affinity( sc_cor* cor_p, int cpu )
+{
+#if defined(__linux__)
+    sc_cor_pthread* c_p = (sc_cor_pthread*)cor_p;
+    if ( !c_p->m_started )
+    {
+        // applied when the thread is created
+        c_p->m_cpu = cpu;
+        return;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO( &cpus );
+    CPU_SET( cpu, &cpus );
+    // a failure (e.g. a CPU taken offline) just leaves the thread unpinned
+    pthread_setaffinity_np( c_p->m_thread, sizeof( cpus ), &cpus );
+#endif
+}
+
+
 // abort the current coroutine (and resume the next coroutine)
 
 void
@@ -333,7 +419,7 @@ sc_cor_pkg_pthread::abort( sc_cor* next_cor_p )
 #ifdef SC_LOCK_CHECK
     assert( is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
-    pthread_cond_signal( &n_p->m_pt_condition );
+    resume( n_p );
 #ifdef SC_LOCK_CHECK
     assert( is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
@@ -346,10 +432,16 @@ sc_cor_pkg_pthread::join( sc_cor* join_cor_p )
 {
     sc_cor_pthread* join_p = (sc_cor_pthread*)join_cor_p;
 
+    if ( !join_p->m_started )
+        return;
     if ( pthread_join( join_p->m_thread, NULL ) )
     {
         std::fprintf(stderr, "ERROR - could not join thread\n");
+        return;
     }
+    join_p->m_started = false;
+    sc_stack_pool::release( join_p->m_stack, join_p->m_stack_size );
+    join_p->m_stack = 0;
 }
 
 
@@ -377,6 +469,18 @@ sc_cor_pkg_pthread::acquire_sched_mutex()
 }
 
 
+// acquire the kernel lock if it is free
+
+bool
+sc_cor_pkg_pthread::try_acquire_sched_mutex()
+{
+#ifdef SC_LOCK_CHECK
+    assert( is_not_owner() );
+#endif /* SC_LOCK_CHECK */
+    return pthread_mutex_trylock( &sched_mutex ) == 0;
+}
+
+
 // release the kernel lock
 
 void
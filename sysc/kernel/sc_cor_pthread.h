@@ -38,7 +38,9 @@
 namespace sc_core {
 
 class sc_cor_pkg_pthread;
+#if !defined(SC_USE_COR_POOL) // see sc_cor_pool.h
 typedef sc_cor_pkg_pthread sc_cor_pkg_t;
+#endif
 
 /**************************************************************************//**
  *  \class sc_cor_pthread
@@ -46,10 +48,15 @@ typedef sc_cor_pkg_pthread sc_cor_pkg_t;
  *  \brief Coroutine class implemented with Posix Threads.
  *
  * Notes:
- *   (1) The thread creation mutex and the creation condition are used to
- *       suspend the thread creating another one until the created thread
- *       reaches its invoke_module_method. This allows us to get control of
- *       thread scheduling away from the pthread package.
+ *   (1) The thread of a coroutine is created by the first go() or handoff()
+ *       to it, so processes that never run cost no thread, and the thread
+ *       runs the core function at once. Its stack comes from
+ *       sc_stack_pool and goes back there when the coroutine is deleted
+ *       after its core function returned.
+ *   (2) A suspended thread sleeps on the futex m_resume rather than on
+ *       m_pt_condition, so that handoff() can release the kernel lock
+ *       before waking up the next thread. Otherwise the next thread would
+ *       wake up only to block on the kernel lock again.
  *****************************************************************************/
 
 class sc_cor_pthread : public sc_cor
@@ -95,12 +102,24 @@ class sc_cor_pthread : public sc_cor
     pthread_cond_t      m_pt_condition; // Condition waiting for.
     pthread_t           m_thread;       // Our pthread storage.
 
+    /**
+     *  \brief Word the thread is suspended on (a futex): 0 from the entry
+     *         of wait(), 1 once resumed by go(), 2 while asleep.
+     */
+    int                 m_resume;
+
     /**
      *  \brief The counter tracking the lock attempts of the kernel lock.
      */
     // 05/27/2015 GL.
     unsigned int        m_counter;
 
+    std::size_t         m_stack_size;   // requested stack size, 0: default
+    char*               m_stack;        // from sc_stack_pool, 0: none
+    int                 m_cpu;          // pinned to at start, -1: none
+    bool                m_started;      // m_thread is created
+    int                 m_done;         // core function returned (atomic)
+
 private:
 
     // disabled
@@ -142,9 +161,20 @@ public:
      */
     virtual void go( sc_cor* next_cor );
 
+    /** 
+     *  \brief Resume the next coroutine and suspend the current one, 
+     *         releasing the kernel lock before the next one is woken up.
+     */
+    virtual void handoff( sc_cor* cur_cor, sc_cor* next_cor );
+
     // abort the current coroutine (and resume the next coroutine)
     virtual void abort( sc_cor* next_cor );
 
+    /** 
+     *  \brief Pin the thread of the coroutine to the given CPU.
+     */
+    virtual void set_affinity( sc_cor* cor, int cpu );
+
     // join another coroutine
     virtual void join( sc_cor* join_cor );
 
@@ -156,6 +186,11 @@ public:
      */
     virtual void acquire_sched_mutex();
 
+    /** 
+     *  \brief Acquire the kernel lock if it is free.
+     */
+    virtual bool try_acquire_sched_mutex();
+
     /** 
      *  \brief Release the kernel lock.
      */
@@ -197,6 +232,18 @@ public:
      */
     virtual bool is_locked_and_owner();
 
+private:
+
+    /**
+     *  \brief Create the thread of the coroutine, which runs at once.
+     */
+    void start( sc_cor_pthread* cor_p );
+
+    /**
+     *  \brief Resume the coroutine, starting its thread on the first call.
+     */
+    void resume( sc_cor_pthread* cor_p );
+
 private:
 
     static int instance_count;
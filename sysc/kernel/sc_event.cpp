@@ -41,6 +41,8 @@
 #endif
 namespace sc_core {
 
+SC_THREAD_LOCAL_ sc_deferred_updates* sc_deferred_updates_p = 0;
+
 // ----------------------------------------------------------------------------
 //  CLASS : sc_event
 //
@@ -66,10 +68,9 @@ sc_event::get_earliest_time_after_certain_time(sc_timestamp t0){
     return t;
     */
 
-    typedef std::set<sc_timestamp>::iterator SIT;
-    SIT it = m_notify_timestamp_set.lower_bound(t0);
-    if(it == m_notify_timestamp_set.end()) return sc_timestamp(-1,-1);
-    else return *it;
+    std::size_t i = m_notify_timestamp_set.lower_bound(t0);
+    if(i == m_notify_timestamp_set.size()) return sc_timestamp(-1,-1);
+    else return m_notify_timestamp_set[i];
 
 }
 
@@ -89,7 +90,7 @@ sc_event::get_earliest_notification_time(){
     return t;
     */
     if(m_notify_timestamp_set.empty()) return sc_timestamp(-1,-1);
-    else return *(m_notify_timestamp_set.begin());
+    else return m_notify_timestamp_set.front();
 
 }
 
@@ -108,8 +109,102 @@ sc_event::erase_notification_time(sc_timestamp t){
         }
     }
     */
-    if(m_notify_timestamp_set.count(t)!=0) m_notify_timestamp_set.erase(t);
+    if(m_notify_timestamp_set.erase(t)) m_notify_set_version++;
+
+}
+
+bool
+sc_event::erase_notification_times_before(const sc_timestamp& t){
+    if(m_notify_timestamp_set.erase_before(t) != 0) {
+        m_notify_set_version++;
+    }
+    return m_notify_timestamp_set.empty();
+}
 
+// ----------------------------------------------------------------------------
+//  CLASS : sc_notify_time_ring
+//
+//  Sorted set of the pending notification times of an event.
+// ----------------------------------------------------------------------------
+
+void
+sc_notify_time_ring::grow()
+{
+    std::size_t capacity = m_buf ? 2 * ( m_mask + 1 ) : 4;
+    sc_timestamp* buf = new sc_timestamp[capacity];
+    for ( std::size_t i = 0; i < m_size; i++ )
+        buf[i] = (*this)[i];
+    delete [] m_buf;
+    m_buf = buf;
+    m_mask = capacity - 1;
+    m_head = 0;
+}
+
+bool
+sc_notify_time_ring::insert( const sc_timestamp& t )
+{
+    // the common case: a time later than all pending ones
+    if ( m_size == 0 || back() < t )
+    {
+        if ( m_buf == 0 || m_size == m_mask + 1 )
+            grow();
+        at( m_size++ ) = t;
+        return true;
+    }
+
+    std::size_t i = lower_bound( t );
+    if ( (*this)[i] == t )
+        return false;
+    if ( m_size == m_mask + 1 )
+        grow();
+
+    if ( i < m_size / 2 )
+    {
+        // move [0, i) one slot towards the front
+        m_head = ( m_head - 1 ) & m_mask;
+        for ( std::size_t j = 0; j < i; j++ )
+            at( j ) = at( j + 1 );
+    }
+    else
+    {
+        // move [i, size) one slot towards the back
+        for ( std::size_t j = m_size; j > i; j-- )
+            at( j ) = at( j - 1 );
+    }
+    at( i ) = t;
+    m_size++;
+    return true;
+}
+
+bool
+sc_notify_time_ring::erase( const sc_timestamp& t )
+{
+    std::size_t i = lower_bound( t );
+    if ( i == m_size || (*this)[i] != t )
+        return false;
+
+    if ( i < m_size / 2 )
+    {
+        for ( std::size_t j = i; j > 0; j-- )
+            at( j ) = at( j - 1 );
+        m_head = ( m_head + 1 ) & m_mask;
+    }
+    else
+    {
+        for ( std::size_t j = i; j + 1 < m_size; j++ )
+            at( j ) = at( j + 1 );
+    }
+    m_size--;
+    return true;
+}
+
+std::size_t
+sc_notify_time_ring::erase_before( const sc_timestamp& t )
+{
+    std::size_t n = lower_bound( t );
+    m_head = ( m_head + n ) & m_mask;
+    m_size -= n;
+    return n;
 }
 
 
@@ -123,6 +218,13 @@ sc_event::basename() const
 void
 sc_event::cancel()
 {
+    // a notification posted before must not be applied after the cancel
+    if ( __atomic_load_n( &m_posted, __ATOMIC_ACQUIRE ) != 0 )
+    {
+        sc_kernel_lock lock;
+        m_simc->drain_notifications();
+    }
+
     // cancel a delta or timed notification
     switch( m_notify_type ) {
     case DELTA: {
@@ -214,6 +316,33 @@ sc_event::notify()
 void
 sc_event::notify( const sc_time& t )
 {
+    // called by update() on a parallel update thread, which neither runs a
+    // process nor may take the kernel lock held by the kernel thread
+    if ( SC_UNLIKELY_( sc_deferred_updates_p != 0 ) )
+    {
+        sc_deferred_update deferred;
+        deferred.m_event_p = this;
+        deferred.m_reset_p = 0;
+        deferred.m_delay = t;
+        sc_deferred_updates_p->push_back( deferred );
+        return;
+    }
+
+    // 08/13/2015 GL: to get the local time stamp of this coroutine
+    sc_process_b* m_proc = m_simc->get_curr_proc();
+    if(m_proc != NULL && m_proc->invoker) { //DM 05/21/2019 special functionality for sc_method invokers
+    	m_proc = m_proc->cur_invoker_method_handle;
+    }
+
+    // a running process does not wait for the kernel lock, but posts the
+    // notification to the next holder of the lock, unless its post queue
+    // is full
+    if ( m_proc != NULL && !m_simc->is_lock_owner() &&
+         m_simc->post_notification( this, m_proc, t ) )
+    {
+        return;
+    }
+
     // 05/25/2015 GL: sc_kernel_lock constructor acquires the kernel lock
     sc_kernel_lock lock;
 
@@ -221,17 +350,29 @@ sc_event::notify( const sc_time& t )
     assert( sc_get_curr_simcontext()->is_locked_and_owner() );
 #endif /* SC_LOCK_CHECK */
 
-    m_simc->event_notification_update = true; //DM 06/23/2019 events can be notified while simulation is paused
+    apply_notification( m_proc, m_proc != NULL ? m_proc->get_timestamp()
+                                               : sc_timestamp(), t );
+    // 05/25/2015 GL: sc_kernel_lock destructor releases the kernel lock
+}
 
-    // 08/13/2015 GL: to get the local time stamp of this coroutine
-    sc_process_b* m_proc = m_simc->get_curr_proc();
-    if(m_proc != NULL && m_proc->invoker) { //DM 05/21/2019 special functionality for sc_method invokers
-    	m_proc = m_proc->cur_invoker_method_handle;
-    }
-    /*if( m_notify_type == DELTA ) {
-        return;
-        // 05/25/2015 GL: sc_kernel_lock destructor releases the kernel lock
-    }*/
+// +----------------------------------------------------------------------------
+// |"sc_event::apply_notification"
+// | 
+// | This method records a notification by process m_proc (NULL if not a 
+// | SystemC process) at its local time proc_ts, with delay t, either directly
+// | from notify() or when the kernel drains the posted notifications.
+// +----------------------------------------------------------------------------
+void
+sc_event::apply_notification( sc_process_b* m_proc,
+                              const sc_timestamp& proc_ts,
+                              const sc_time& t )
+{
+    // assume we have acquired the kernel lock upon here
+#ifdef SC_LOCK_CHECK
+    assert( sc_get_curr_simcontext()->is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+
+    m_simc->event_notification_update = true; //DM 06/23/2019 events can be notified while simulation is paused
 
     if(m_proc != NULL)
     {
@@ -241,7 +382,7 @@ sc_event::notify( const sc_time& t )
 	if(getenv(_SYSC_PRINT_VERBOSE_MESSAGE_ENV_VAR)){
 		if(m_proc != NULL) { //DM ADDING FOR SIMICS
     		printf("sc_event.cpp 161 event %s notified by %s on time ",this->name(),m_proc->name());
-    		sc_timestamp ts_tmp=m_proc->get_timestamp();
+    		sc_timestamp ts_tmp=proc_ts;
     		sc_time t_tmp=ts_tmp.get_time_count();
     		t_tmp.print();
     		printf(",%lld\n",ts_tmp.get_delta_count());  
@@ -284,8 +425,8 @@ sc_event::notify( const sc_time& t )
 	//	push_notify_timestamp_list(m_proc->get_timestamp());
 	if(m_proc != NULL) { //DM ADDING TO CHECK IF THE CURRENT PROC IS A SYSTEMC PROC
 
-		set_notify_timestamp( m_proc->get_timestamp() );
-		push_notify_timestamp_list(m_proc->get_timestamp());
+		set_notify_timestamp( proc_ts );
+		push_notify_timestamp_list(proc_ts);
 	} else {
 		//DM MAKING ASSUMPTION THAT SIMULATION IS NOT RUNNNING AND THE THREAD WAITING ON 
 		//THE EVENT BEING NOTIFIED IS EXCLUSIVELY NOTIFIED BY A NON-SYSTEMC THREAD
@@ -348,9 +489,9 @@ sc_event::notify( const sc_time& t )
         //  push_notify_timestamp_list(m_proc->get_timestamp());
         if(m_proc != NULL) { //DM ADDING TO CHECK IF THE CURRENT PROC IS A SYSTEMC PROC
 
-            set_notify_timestamp( sc_timestamp( m_proc->get_timestamp().
+            set_notify_timestamp( sc_timestamp( proc_ts.
                                         get_time_count() + t, 0 ) );
-            push_notify_timestamp_list(sc_timestamp( m_proc->get_timestamp().
+            push_notify_timestamp_list(sc_timestamp( proc_ts.
                                         get_time_count() + t, 0 ) );
         } else {
             //DM MAKING ASSUMPTION THAT SIMULATION IS NOT RUNNNING AND THE THREAD WAITING ON 
@@ -586,6 +727,9 @@ sc_event::sc_event( const char* name ) :
 	m_notify_type( NONE ), 
 	m_delta_event_index( -1 )
 {
+    m_notify_set_version = 0;
+    m_wakeup_version = 0;
+    m_posted = 0;
     // Skip simulator's internally defined events.
 
     register_event( name );
@@ -607,6 +751,9 @@ sc_event::sc_event() :
 	m_notify_type( NONE ), 
 	m_delta_event_index( -1 )
 {
+    m_notify_set_version = 0;
+    m_wakeup_version = 0;
+    m_posted = 0;
 
     register_event( NULL );
 }
@@ -843,7 +990,7 @@ void
 sc_event::push_notify_timestamp_list( const sc_timestamp& ts )
 {
 //    m_notify_timestamp_list.push_back( ts );
-    m_notify_timestamp_set.insert( ts );
+    if(m_notify_timestamp_set.insert( ts )) m_notify_set_version++;
 }
 // ----------------------------------------------------------------------------
 //  CLASS : sc_event_timed
@@ -251,6 +251,90 @@ public:
 
 typedef sc_event_expr<sc_event_or_list> sc_event_or_expr;
 
+/**************************************************************************//**
+ *  \class sc_notify_time_ring
+ *
+ *  \brief Sorted set of the pending notification times of an event, kept in
+ *         a ring buffer.
+ *
+ *  Notifications mostly arrive in time order and expire from the front, so
+ *  an insert is usually an append and trimming only moves the head. Other
+ *  inserts and erases shift the shorter side of the ring. The buffer only 
+ *  grows, doubling its capacity, so a steady stream of notifications does
+ *  not allocate.
+ *****************************************************************************/
+
+class sc_notify_time_ring
+{
+public:
+
+    sc_notify_time_ring()
+        : m_buf( 0 ), m_mask( 0 ), m_head( 0 ), m_size( 0 ) {}
+    ~sc_notify_time_ring() { delete [] m_buf; }
+
+    bool        empty() const { return m_size == 0; }
+    std::size_t size() const  { return m_size; }
+
+    const sc_timestamp& operator [] ( std::size_t i ) const
+        { return m_buf[( m_head + i ) & m_mask]; }
+    const sc_timestamp& front() const { return (*this)[0]; }
+    const sc_timestamp& back() const  { return (*this)[m_size - 1]; }
+
+    /**
+     *  \brief Index of the first time not less than t, size() if none.
+     */
+    inline std::size_t lower_bound( const sc_timestamp& t ) const;
+
+    /**
+     *  \brief Insert t, returns false if it is present already.
+     */
+    bool insert( const sc_timestamp& t );
+
+    /**
+     *  \brief Erase t, returns false if it is not present.
+     */
+    bool erase( const sc_timestamp& t );
+
+    /**
+     *  \brief Erase all times less than t, returns how many were erased.
+     */
+    std::size_t erase_before( const sc_timestamp& t );
+
+private:
+
+    sc_timestamp& at( std::size_t i ) { return m_buf[( m_head + i ) & m_mask]; }
+    void grow();
+
+private:
+
+    sc_timestamp* m_buf;    // capacity is m_mask + 1, a power of 2
+    std::size_t   m_mask;
+    std::size_t   m_head;   // index of the earliest time in m_buf
+    std::size_t   m_size;
+
+private:
+
+    // disabled
+    sc_notify_time_ring( const sc_notify_time_ring& );
+    sc_notify_time_ring& operator = ( const sc_notify_time_ring& );
+};
+
+inline std::size_t
+sc_notify_time_ring::lower_bound( const sc_timestamp& t ) const
+{
+    std::size_t lo = 0;
+    std::size_t hi = m_size;
+    while ( lo < hi )
+    {
+        std::size_t mid = lo + ( ( hi - lo ) >> 1 );
+        if ( (*this)[mid] < t )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
 /**************************************************************************//**
  *  \class sc_event
  *
@@ -274,7 +358,7 @@ public:
 	
     //a vector that contains all the notification timestamp of this event
     //std::vector<sc_timestamp>    m_notify_timestamp_list;
-	std::set<sc_timestamp>    m_notify_timestamp_set;
+	sc_notify_time_ring       m_notify_timestamp_set;
 
     //returns the min value of m_notify_timestamp_list
     sc_timestamp get_earliest_notification_time();
@@ -285,6 +369,20 @@ public:
     //erase it from the m_notify_timestamp_list
     void erase_notification_time(sc_timestamp);
 
+    //erase all notification times earlier than the argument,
+    //returns true if no notification time is left
+    bool erase_notification_times_before(const sc_timestamp&);
+
+    //bumped whenever m_notify_timestamp_set changes; the wake-up prediction
+    //re-evaluates the waiters of this event only if it differs from
+    //m_wakeup_version, the version it saw last
+    unsigned int              m_notify_set_version;
+    unsigned int              m_wakeup_version;
+
+    //number of notifications of this event posted by running processes and
+    //not yet drained by the kernel (see sc_simcontext::post_notification)
+    unsigned int              m_posted;
+
     sc_event();
     sc_event( const char* name );
     ~sc_event();
@@ -337,6 +435,13 @@ private:
     void notify_internal( const sc_time& );
     void notify_next_delta();
 
+    /** 
+     *  \brief Record a notification by a process at its local time, with
+     *         the kernel lock held.
+     */
+    void apply_notification( sc_process_b*, const sc_timestamp&,
+                             const sc_time& );
+
     bool remove_static( sc_method_handle ) const;
     bool remove_static( sc_thread_handle ) const;
     bool remove_dynamic( sc_method_handle ) const;
@@ -389,6 +494,29 @@ public:
 
 extern sc_event sc_non_event; // Event that never happens.
 
+class sc_reset;
+
+/**
+ *  \brief A notification by sc_prim_channel::update() on a parallel update
+ *         thread, either of an event (m_reset_p is 0) or of the processes
+ *         of a reset signal. It is applied later by the kernel thread, in
+ *         the order of the serial update phase (see
+ *         sc_prim_channel_registry::perform_update).
+ */
+struct sc_deferred_update {
+    sc_event* m_event_p;
+    sc_reset* m_reset_p;
+    sc_time   m_delay;
+};
+
+typedef std::vector<sc_deferred_update> sc_deferred_updates;
+
+/**
+ *  \brief The notifications of the update() calls on this thread are
+ *         deferred to this list while it is not 0.
+ */
+extern SC_THREAD_LOCAL_ sc_deferred_updates* sc_deferred_updates_p;
+
 /**************************************************************************//**
  *  \class sc_event_timed
  *
@@ -399,13 +527,14 @@ class sc_event_timed
 {
     friend class sc_event;
     friend class sc_simcontext;
+    friend class sc_timed_event_calendar;
 
     friend int sc_notify_time_compare( const void*, const void* );
 
 private:
 
     sc_event_timed( sc_event* e, const sc_time& t )
-        : m_event( e ), m_notify_time( t )
+        : m_event( e ), m_notify_time( t ), m_next( 0 )
         {}
 
     ~sc_event_timed()
@@ -431,8 +560,9 @@ private:
 
 private:
 
-    sc_event* m_event;
-    sc_time   m_notify_time;
+    sc_event*       m_event;
+    sc_time         m_notify_time;
+    sc_event_timed* m_next;         // in a bucket of sc_timed_event_calendar
 
 private:
 
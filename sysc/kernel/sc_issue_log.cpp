@@ -0,0 +1,214 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_issue_log.cpp -- Record and replay of the issue decisions of the
+                      out-of-order scheduler.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_issue_log.h"
+#include "sysc/kernel/sc_process.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace sc_core {
+
+// the file starts with the magic and the version, followed by the records
+// in the byte order of the host
+
+static const char         sc_issue_log_magic[4] = { 'S', 'C', 'I', 'L' };
+static const unsigned int sc_issue_log_version = 1;
+
+// records buffered before they are written while recording
+#define SC_ISSUE_LOG_BUFFER 4096
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_issue_log
+// ----------------------------------------------------------------------------
+
+sc_issue_log*
+sc_issue_log::create()
+{
+    const char* record = std::getenv( _SYSC_RECORD_ENV_VAR );
+    const char* replay = std::getenv( _SYSC_REPLAY_ENV_VAR );
+    if ( record != NULL && *record == 0 )
+        record = NULL;
+    if ( replay != NULL && *replay == 0 )
+        replay = NULL;
+    if ( record == NULL && replay == NULL )
+        return 0;
+
+    if ( record != NULL && replay != NULL )
+    {
+        std::cout << _SYSC_RECORD_ENV_VAR << " and " << _SYSC_REPLAY_ENV_VAR
+                  << " cannot be set together" << std::endl;
+        exit(1);
+    }
+
+    const char* file_name = record != NULL ? record : replay;
+    std::FILE*  file = std::fopen( file_name, record != NULL ? "wb" : "rb" );
+    if ( file == NULL )
+    {
+        std::cout << "Cannot open the issue log " << file_name << std::endl;
+        exit(1);
+    }
+
+    sc_issue_log* log = new sc_issue_log( file, replay != NULL );
+    if ( replay != NULL )
+    {
+        log->read();
+    }
+    else
+    {
+        std::fwrite( sc_issue_log_magic, 1, sizeof( sc_issue_log_magic ),
+                     file );
+        std::fwrite( &sc_issue_log_version, sizeof( sc_issue_log_version ),
+                     1, file );
+    }
+    return log;
+}
+
+sc_issue_log::sc_issue_log( std::FILE* file, bool replay )
+    : m_file( file ), m_replay( replay ), m_records(), m_next( 0 )
+{
+    if ( !replay )
+        m_records.reserve( SC_ISSUE_LOG_BUFFER );
+}
+
+sc_issue_log::~sc_issue_log()
+{
+    flush();
+    std::fclose( m_file );
+}
+
+int
+sc_issue_log::proc_id_of( sc_process_b* process_h )
+{
+    return process_h->proc_id;
+}
+
+void
+sc_issue_log::read()
+{
+    char         magic[sizeof( sc_issue_log_magic )];
+    unsigned int version = 0;
+    if ( std::fread( magic, 1, sizeof( magic ), m_file ) != sizeof( magic ) ||
+         std::memcmp( magic, sc_issue_log_magic, sizeof( magic ) ) != 0 ||
+         std::fread( &version, sizeof( version ), 1, m_file ) != 1 ||
+         version != sc_issue_log_version )
+    {
+        std::cout << "The file of " << _SYSC_REPLAY_ENV_VAR
+                  << " is no issue log of this version" << std::endl;
+        exit(1);
+    }
+
+    sc_issue_record record;
+    while ( std::fread( &record, sizeof( record ), 1, m_file ) == 1 )
+        m_records.push_back( record );
+}
+
+void
+sc_issue_log::issued( sc_process_b* process_h )
+{
+    const sc_timestamp& ts = process_h->get_timestamp();
+
+    if ( !m_replay )
+    {
+        sc_issue_record record;
+        record.proc_id = process_h->proc_id;
+        record.seg_id = process_h->get_segment_id();
+        record.time = ts.get_time_count().value();
+        record.delta = ts.get_delta_count();
+        m_records.push_back( record );
+        if ( m_records.size() == SC_ISSUE_LOG_BUFFER )
+            flush();
+        return;
+    }
+
+    if ( m_next >= m_records.size() )
+    {
+        if ( m_next++ == m_records.size() )
+            std::cout << "Replay: end of the issue log, the scheduler runs "
+                      << "free from here" << std::endl;
+        return;
+    }
+
+    const sc_issue_record& record = m_records[m_next];
+    if ( record.seg_id != process_h->get_segment_id() )
+        diverged( "issued in another segment", process_h );
+    if ( record.time != ts.get_time_count().value() ||
+         record.delta != ts.get_delta_count() )
+        diverged( "issued at another time", process_h );
+    m_next++;
+}
+
+void
+sc_issue_log::stalled() const
+{
+    if ( m_next < m_records.size() )
+        diverged( "not ready while no process runs", 0 );
+}
+
+void
+sc_issue_log::diverged( const char* reason, sc_process_b* process_h ) const
+{
+    const sc_issue_record& record = m_records[m_next];
+    std::cout << "Replay diverged at issue " << m_next << " of "
+              << m_records.size() << ": process " << record.proc_id
+              << " (segment " << record.seg_id << ", time " << record.time
+              << ", delta " << record.delta << ") " << reason;
+    if ( process_h != 0 )
+        std::cout << ": " << process_h->name() << " (segment "
+                  << process_h->get_segment_id() << ", time "
+                  << process_h->get_timestamp().get_time_count().value()
+                  << ", delta "
+                  << process_h->get_timestamp().get_delta_count() << ")";
+    std::cout << std::endl;
+    exit(1);
+}
+
+void
+sc_issue_log::flush()
+{
+    if ( m_replay || m_records.empty() )
+        return;
+    std::fwrite( &m_records[0], sizeof( sc_issue_record ), m_records.size(),
+                 m_file );
+    std::fflush( m_file );
+    m_records.clear();
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
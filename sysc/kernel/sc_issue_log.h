@@ -0,0 +1,166 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_issue_log.h -- Record and replay of the issue decisions of the
+                    out-of-order scheduler.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_ISSUE_LOG_H
+#define SC_ISSUE_LOG_H
+
+#include "sysc/kernel/sc_time.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace sc_core {
+
+class sc_process_b;
+
+/**
+ *  \brief Environment variable naming the file the issue decisions are
+ *         recorded to.
+ */
+#ifndef _SYSC_RECORD_ENV_VAR
+#define _SYSC_RECORD_ENV_VAR "SYSC_RECORD"
+#endif
+
+/**
+ *  \brief Environment variable naming a recorded file whose issue order is
+ *         forced on the scheduler.
+ */
+#ifndef _SYSC_REPLAY_ENV_VAR
+#define _SYSC_REPLAY_ENV_VAR "SYSC_REPLAY"
+#endif
+
+/**
+ *  \brief One issue decision: the process (sc_process_b::proc_id), the
+ *         segment it was issued in, and its time stamp.
+ */
+struct sc_issue_record {
+    int                 proc_id;
+    int                 seg_id;
+    sc_time::value_type time;       // in time resolution units
+    sc_dt::uint64       delta;
+};
+
+/**************************************************************************//**
+ *  \class sc_issue_log
+ *
+ *  \brief The sequence of processes issued by oooschedule(), recorded to a
+ *         binary file while _SYSC_RECORD_ENV_VAR is set, or replayed from
+ *         one while _SYSC_REPLAY_ENV_VAR is set.
+ *
+ *  Recording only appends a fixed-size record to a buffer per issue, so the
+ *  parallel run is not slowed down. A run killed while hanging loses the
+ *  last buffer at most.
+ *
+ *  In replay the scheduler issues a process only when it is the next one in
+ *  the log, and still only when it has no conflicts, so the processes issue
+ *  in the recorded order while those issued together still run in parallel.
+ *  A replay that cannot go on (the next process is not ready while nothing
+ *  runs, or it is issued in another segment or at another time) stops with
+ *  the diverging record. Past the end of the log the scheduler runs free.
+ *
+ *  Processes are identified by their creation order, so a replay needs the
+ *  same model and the same elaboration as the recording. All functions are
+ *  called with the kernel lock held.
+ *****************************************************************************/
+
+class sc_issue_log
+{
+public:
+
+    /**
+     *  \brief The log selected by the environment, or 0 if neither variable
+     *         is set.
+     */
+    static sc_issue_log* create();
+
+    ~sc_issue_log();
+
+    bool replaying() const { return m_replay; }
+
+    /**
+     *  \brief Whether the scheduler may issue process_h now: always while
+     *         recording, only for the next process of the log in replay.
+     */
+    bool may_issue( sc_process_b* process_h ) const
+        { return !m_replay || m_next >= m_records.size() ||
+                 m_records[m_next].proc_id == proc_id_of( process_h ); }
+
+    /**
+     *  \brief Record the issue of process_h, or check it against the log in
+     *         replay.
+     */
+    void issued( sc_process_b* process_h );
+
+    /**
+     *  \brief Stop a replay in which nothing could be issued while no
+     *         process is running.
+     */
+    void stalled() const;
+
+    /**
+     *  \brief Write the buffered records to the file.
+     */
+    void flush();
+
+private:
+
+    sc_issue_log( std::FILE* file, bool replay );
+
+    static int proc_id_of( sc_process_b* process_h );
+
+    void read();
+    void diverged( const char* reason, sc_process_b* process_h ) const;
+
+private:
+
+    std::FILE*                   m_file;
+    bool                         m_replay;
+    std::vector<sc_issue_record> m_records;     // buffer, or the whole log
+    std::size_t                  m_next;        // next record to replay
+
+private:
+
+    // disabled
+    sc_issue_log( const sc_issue_log& );
+    sc_issue_log& operator = ( const sc_issue_log& );
+};
+
+} // namespace sc_core
+
+#endif // SC_ISSUE_LOG_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
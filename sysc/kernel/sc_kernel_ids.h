@@ -198,6 +198,12 @@ SC_DEFINE_MESSAGE(SC_ID_RESET_PROCESS_WHILE_NOT_RUNNING_  , 573,
         "a process may not be asynchronously reset while the simulation is not running" )
 SC_DEFINE_MESSAGE(SC_ID_THROW_IT_WHILE_NOT_RUNNING_  , 574,
         "throw_it not allowed unless simulation is running " )
+SC_DEFINE_MESSAGE(SC_ID_COR_POOL_WORKER_  , 575,
+        "could not create a worker thread of the coroutine pool" )
+SC_DEFINE_MESSAGE(SC_ID_COR_STACK_ALLOC_  , 576,
+        "could not allocate a coroutine stack" )
+SC_DEFINE_MESSAGE(SC_ID_COR_POOL_AFFINITY_  , 577,
+        "SYSC_AFFINITY has no effect with the coroutine pool package" )
 
 
 /*****************************************************************************
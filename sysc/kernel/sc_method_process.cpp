@@ -1089,8 +1089,8 @@ bool sc_method_process::deliver_event_at_time( sc_event* e,
 
         //push thread to ready queue
         if(_SYSC_SYNC_PAR_SIM==true){
-            simcontext()->m_synch_thread_queue.push_back(this);
             this->m_process_state=32;
+            simcontext()->push_synch_process(this);
  
         }else{
             if(sc_core::verbosity_flag_4)
@@ -1448,8 +1448,8 @@ bool sc_method_process::trigger_dynamic( sc_event* e, bool& can_wake_up )
 
         //push thread to ready queue
         if(_SYSC_SYNC_PAR_SIM==true){
-            simcontext()->m_synch_thread_queue.push_back(this);
             this->m_process_state=32;
+            simcontext()->push_synch_process(this);
  
         }else{
             simcontext()->push_runnable_method(this);
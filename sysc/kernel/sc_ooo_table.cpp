@@ -0,0 +1,672 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_ooo_table.cpp -- Compact storage of the out-of-order scheduling tables
+                      and the versioned, memory-mapped table file format.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_ooo_table.h"
+#include "sysc/kernel/sc_simcontext.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sc_core {
+
+sc_ooo_matrix _OoO_Data_Conflict_Matrix;
+sc_ooo_matrix _OoO_Event_Notify_Matrix;
+sc_ooo_matrix _OoO_Combined_Data_Conflict_Matrix;
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_ooo_matrix
+// ----------------------------------------------------------------------------
+
+void
+sc_ooo_matrix::attach_dense( const bool* table, std::size_t rows,
+                             std::size_t cols )
+{
+    *this = sc_ooo_matrix();
+    m_storage = DENSE_BOOL;
+    m_rows = rows;
+    m_cols = cols;
+    m_bool = table;
+}
+
+void
+sc_ooo_matrix::attach_dense( const int* table, std::size_t rows,
+                             std::size_t cols )
+{
+    *this = sc_ooo_matrix();
+    m_storage = DENSE_INT;
+    m_rows = rows;
+    m_cols = cols;
+    m_int = table;
+}
+
+void
+sc_ooo_matrix::attach_bits( const uint64_t* words, std::size_t rows,
+                            std::size_t cols )
+{
+    *this = sc_ooo_matrix();
+    m_storage = BITS;
+    m_rows = rows;
+    m_cols = cols;
+    m_words_per_row = ( cols + 63 ) / 64;
+    m_bits = words;
+}
+
+void
+sc_ooo_matrix::attach_csr( const uint64_t* row_ptr, const uint32_t* col_idx,
+                           const int32_t* values, std::size_t rows,
+                           std::size_t cols )
+{
+    *this = sc_ooo_matrix();
+    m_storage = CSR;
+    m_rows = rows;
+    m_cols = cols;
+    m_row_ptr = row_ptr;
+    m_col_idx = col_idx;
+    m_values = values;
+}
+
+std::size_t
+sc_ooo_matrix::footprint() const
+{
+    switch ( m_storage )
+    {
+        case DENSE_BOOL:
+            return m_rows * m_cols * sizeof( bool );
+        case DENSE_INT:
+            return m_rows * m_cols * sizeof( int );
+        case BITS:
+            return m_rows * m_words_per_row * sizeof( uint64_t );
+        case CSR:
+        {
+            std::size_t nnz = m_row_ptr[m_rows];
+            return ( m_rows + 1 ) * sizeof( uint64_t ) +
+                   nnz * sizeof( uint32_t ) +
+                   ( m_values ? nnz * sizeof( int32_t ) : 0 );
+        }
+        default:
+            return 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_ooo_conflict_filter
+// ----------------------------------------------------------------------------
+
+void
+sc_ooo_conflict_filter::build( const sc_ooo_matrix& combined )
+{
+    m_size = combined.rows();
+    m_words = ( m_size + 63 ) / 64;
+    m_rows.assign( m_size * m_words, 0 );
+    m_active.assign( m_words, 0 );
+    m_count.assign( m_size, 0 );
+
+    // visit the non-zero entries (j, i) row by row in the encoding of the
+    // table, rather than probing every pair
+    for ( std::size_t j = 0; j < m_size; j++ )
+    {
+        uint64_t bit = (uint64_t)1 << ( j & 63 );
+        std::size_t word = j >> 6;
+
+        switch ( combined.m_storage )
+        {
+            case sc_ooo_matrix::DENSE_BOOL:
+            {
+                const bool* row_p = combined.m_bool + j * combined.m_cols;
+                for ( std::size_t i = 0; i < m_size; i++ )
+                    if ( row_p[i] )
+                        m_rows[i * m_words + word] |= bit;
+                break;
+            }
+            case sc_ooo_matrix::DENSE_INT:
+            {
+                const int* row_p = combined.m_int + j * combined.m_cols;
+                for ( std::size_t i = 0; i < m_size; i++ )
+                    if ( row_p[i] != 0 )
+                        m_rows[i * m_words + word] |= bit;
+                break;
+            }
+            case sc_ooo_matrix::BITS:
+            {
+                const uint64_t* row_p =
+                    combined.m_bits + j * combined.m_words_per_row;
+                for ( std::size_t w = 0; w < combined.m_words_per_row; w++ )
+                {
+                    std::size_t i = w * 64;
+                    for ( uint64_t set = row_p[w]; set != 0; set >>= 1, i++ )
+                        if ( ( set & 1 ) && i < m_size )
+                            m_rows[i * m_words + word] |= bit;
+                }
+                break;
+            }
+            case sc_ooo_matrix::CSR:
+            {
+                for ( uint64_t k = combined.m_row_ptr[j];
+                      k < combined.m_row_ptr[j + 1]; k++ )
+                {
+                    if ( combined.m_values && combined.m_values[k] == 0 )
+                        continue;
+                    m_rows[combined.m_col_idx[k] * m_words + word] |= bit;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void
+sc_ooo_conflict_filter::activate( int id )
+{
+    if ( m_count[id]++ == 0 )
+        m_active[id >> 6] |= (uint64_t)1 << ( id & 63 );
+}
+
+void
+sc_ooo_conflict_filter::deactivate( int id )
+{
+    assert( m_count[id] > 0 );
+    if ( --m_count[id] == 0 )
+        m_active[id >> 6] &= ~( (uint64_t)1 << ( id & 63 ) );
+}
+
+// ----------------------------------------------------------------------------
+//  table file
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// the mapping of the packed table file, kept until the end of the program
+void*       table_file_map = MAP_FAILED;
+std::size_t table_file_bytes = 0;
+
+inline uint64_t
+align8( uint64_t n )
+{
+    return ( n + 7 ) & ~(uint64_t)7;
+}
+
+void
+table_file_error( const char* file_name, const char* msg )
+{
+    std::cout << "Invalid table file " << file_name << ": " << msg
+              << std::endl;
+    exit(1);
+}
+
+// description of a table array of the model
+struct raw_table {
+    void*       data;
+    std::size_t bytes;
+};
+
+// the table arrays of the model, indexed by sc_ooo_table_id
+void
+get_raw_tables( raw_table tables[SC_OOO_NUM_TABLES] )
+{
+    std::size_t dc = _OoO_Data_Conflict_Table_Size;
+    std::size_t en = _OoO_Event_Notify_Table_Size;
+
+    tables[SC_OOO_DATA_CONFLICT].data = _OoO_Data_Conflict_Table;
+    tables[SC_OOO_DATA_CONFLICT].bytes = dc * dc * sizeof( bool );
+    tables[SC_OOO_EVENT_NOTIFY].data = _OoO_Event_Notify_Table;
+    tables[SC_OOO_EVENT_NOTIFY].bytes = en * en * sizeof( bool );
+    tables[SC_OOO_CONFLICT_INDEX_LOOKUP].data =
+        _OoO_Conflict_Index_Lookup_Table;
+    tables[SC_OOO_CONFLICT_INDEX_LOOKUP].bytes =
+        ( _OoO_Max_Number_of_Instances + 1 ) * _OoO_Number_of_Segments *
+        sizeof( int );
+    tables[SC_OOO_CURR_TIME_ADVANCE_TIME].data =
+        _OoO_Curr_Time_Advance_Table_Time;
+    tables[SC_OOO_CURR_TIME_ADVANCE_TIME].bytes =
+        _OoO_Curr_Time_Advance_Table_Size * sizeof( long long );
+    tables[SC_OOO_CURR_TIME_ADVANCE_DELTA].data =
+        _OoO_Curr_Time_Advance_Table_Delta;
+    tables[SC_OOO_CURR_TIME_ADVANCE_DELTA].bytes =
+        _OoO_Curr_Time_Advance_Table_Size * sizeof( int );
+    tables[SC_OOO_NEXT_TIME_ADVANCE_TIME].data =
+        _OoO_Next_Time_Advance_Table_Time;
+    tables[SC_OOO_NEXT_TIME_ADVANCE_TIME].bytes =
+        _OoO_Next_Time_Advance_Table_Size * sizeof( long long );
+    tables[SC_OOO_NEXT_TIME_ADVANCE_DELTA].data =
+        _OoO_Next_Time_Advance_Table_Delta;
+    tables[SC_OOO_NEXT_TIME_ADVANCE_DELTA].bytes =
+        _OoO_Next_Time_Advance_Table_Size * sizeof( int );
+    tables[SC_OOO_TIME_ADVANCE_INDEX_LOOKUP].data =
+        _OoO_Time_Advance_Index_Lookup_Table;
+    tables[SC_OOO_TIME_ADVANCE_INDEX_LOOKUP].bytes =
+        _OoO_Time_Advance_Index_Lookup_Table_Size * sizeof( int );
+    tables[SC_OOO_COMBINED_DATA_CONFLICT].data =
+        _OoO_Combined_Data_Conflict_Table;
+    tables[SC_OOO_COMBINED_DATA_CONFLICT].bytes =
+        _OoO_Combined_Data_Conflict_Table_Size * sizeof( int );
+    tables[SC_OOO_COMBINED_DATA_CONFLICT_LOOKUP].data =
+        _OoO_Combined_Data_Conflict_Lookup_Table;
+    tables[SC_OOO_COMBINED_DATA_CONFLICT_LOOKUP].bytes =
+        _OoO_Combined_Data_Conflict_Lookup_Table_Number_Segments *
+        ( 1 + _OoO_Combined_Data_Conflict_Lookup_Table_Max_Instances ) *
+        sizeof( int );
+    tables[SC_OOO_PREDICTION_TIME_ADVANCE_TIME_UNITS].data =
+        _OoO_Prediction_Time_Advance_Table_Time_Units;
+    tables[SC_OOO_PREDICTION_TIME_ADVANCE_TIME_UNITS].bytes =
+        _OoO_Prediction_Time_Advance_Table_Number_Segments *
+        ( 1 + _OoO_Prediction_Time_Advance_Table_Number_Steps ) *
+        sizeof( long long );
+    tables[SC_OOO_PREDICTION_TIME_ADVANCE_DELTA].data =
+        _OoO_Prediction_Time_Advance_Table_Delta;
+    tables[SC_OOO_PREDICTION_TIME_ADVANCE_DELTA].bytes =
+        _OoO_Prediction_Time_Advance_Table_Number_Segments *
+        ( 1 + _OoO_Prediction_Time_Advance_Table_Number_Steps ) *
+        sizeof( int );
+    tables[SC_OOO_PREDICTION_TIME_ADVANCE_LOOKUP].data =
+        _OoO_Prediction_Time_Advance_Lookup_Table;
+    tables[SC_OOO_PREDICTION_TIME_ADVANCE_LOOKUP].bytes =
+        _OoO_Prediction_Time_Advance_Table_Number_Segments * sizeof( int );
+    tables[SC_OOO_PREDICTION_EVENT_NOTIFY_TIME_UNITS].data =
+        _OoO_Prediction_Event_Notification_Table_No_Indirect_Time_Units;
+    tables[SC_OOO_PREDICTION_EVENT_NOTIFY_TIME_UNITS].bytes =
+        _OoO_Combined_Data_Conflict_Table_Size * sizeof( long long );
+    tables[SC_OOO_PREDICTION_EVENT_NOTIFY_DELTA].data =
+        _OoO_Prediction_Event_Notification_Table_No_Indirect_Delta;
+    tables[SC_OOO_PREDICTION_EVENT_NOTIFY_DELTA].bytes =
+        _OoO_Combined_Data_Conflict_Table_Size * sizeof( int );
+    tables[SC_OOO_PREDICTION_EVENT_NOTIFY_LOOKUP].data =
+        _OoO_Prediction_Event_Notification_No_Indirect_Lookup_Table;
+    tables[SC_OOO_PREDICTION_EVENT_NOTIFY_LOOKUP].bytes =
+        _OoO_Prediction_Event_Notification_Table_No_Indirect_Number_Segments *
+        ( 1 + _OoO_Prediction_Event_Notification_Table_No_Indirect_Max_Instances ) *
+        sizeof( int );
+}
+
+std::size_t
+combined_table_dim()
+{
+    return (std::size_t)sqrt( (double)_OoO_Combined_Data_Conflict_Table_Size );
+}
+
+// attach a matrix view to a mapped section
+void
+attach_section( sc_ooo_matrix& m, const sc_ooo_table_section& s,
+                const char* base, bool is_int, const raw_table& raw,
+                const char* file_name )
+{
+    const char* data = base + s.offset;
+    switch ( s.encoding )
+    {
+        case SC_OOO_TABLE_RAW:
+            if ( s.bytes != raw.bytes )
+                table_file_error( file_name, "table size mismatch" );
+            // keep the table array of the model valid as well
+            std::memcpy( raw.data, data, s.bytes );
+            if ( is_int )
+                m.attach_dense( (const int*)raw.data, s.rows, s.cols );
+            else
+                m.attach_dense( (const bool*)raw.data, s.rows, s.cols );
+            break;
+        case SC_OOO_TABLE_BITS:
+            if ( is_int )
+                table_file_error( file_name, "bit encoding of an int table" );
+            if ( s.bytes != s.rows * ( ( s.cols + 63 ) / 64 ) * 8 )
+                table_file_error( file_name, "bad bit table size" );
+            m.attach_bits( (const uint64_t*)data, s.rows, s.cols );
+            break;
+        case SC_OOO_TABLE_CSR:
+        {
+            const uint64_t* row_ptr = (const uint64_t*)data;
+            uint64_t cols_off = ( s.rows + 1 ) * sizeof( uint64_t );
+            uint64_t vals_off = cols_off + align8( s.nnz * sizeof( uint32_t ) );
+            uint64_t expected = vals_off +
+                                ( is_int ? s.nnz * sizeof( int32_t ) : 0 );
+            if ( s.bytes != expected || row_ptr[s.rows] != s.nnz )
+                table_file_error( file_name, "bad sparse table size" );
+            // get() indexes by these without checks, so check them once here
+            const uint32_t* col_idx = (const uint32_t*)( data + cols_off );
+            for ( uint64_t r = 0; r < s.rows; r++ )
+            {
+                if ( row_ptr[r] > row_ptr[r + 1] )
+                    table_file_error( file_name, "bad sparse table row" );
+            }
+            for ( uint64_t k = 0; k < s.nnz; k++ )
+            {
+                if ( col_idx[k] >= s.cols )
+                    table_file_error( file_name, "bad sparse table column" );
+            }
+            m.attach_csr( row_ptr, col_idx,
+                          is_int ? (const int32_t*)( data + vals_off ) : 0,
+                          s.rows, s.cols );
+            break;
+        }
+        default:
+            table_file_error( file_name, "unknown table encoding" );
+    }
+}
+
+} // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//  FUNCTION : sc_ooo_map_table_file
+// ----------------------------------------------------------------------------
+
+bool
+sc_ooo_map_table_file( const char* file_name )
+{
+    int fd = open( file_name, O_RDONLY );
+    if ( fd < 0 )
+    {
+        std::cout << "Can't open the table file: " << file_name << std::endl;
+        exit(1);
+    }
+
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 ||
+         (std::size_t)st.st_size < sizeof( sc_ooo_table_header ) )
+    {
+        close( fd );
+        return false;
+    }
+
+    sc_ooo_table_header header;
+    if ( pread( fd, &header, sizeof( header ), 0 ) != sizeof( header ) ||
+         std::memcmp( header.magic, SC_OOO_TABLE_MAGIC, 8 ) != 0 )
+    {
+        // not a packed table file
+        close( fd );
+        return false;
+    }
+    if ( header.version != SC_OOO_TABLE_VERSION )
+    {
+        close( fd );
+        table_file_error( file_name, "unsupported version" );
+    }
+
+    std::size_t bytes = st.st_size;
+    void* map = mmap( 0, bytes, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( map == MAP_FAILED )
+        table_file_error( file_name, "mmap failed" );
+
+    const char* base = (const char*)map;
+    const sc_ooo_table_section* sections =
+        (const sc_ooo_table_section*)( base + sizeof( sc_ooo_table_header ) );
+    if ( sizeof( sc_ooo_table_header ) +
+         (uint64_t)header.num_sections * sizeof( sc_ooo_table_section ) >
+         bytes )
+        table_file_error( file_name, "truncated section table" );
+
+    raw_table raw[SC_OOO_NUM_TABLES];
+    get_raw_tables( raw );
+    bool seen[SC_OOO_NUM_TABLES] = { false };
+
+    for ( uint32_t i = 0; i < header.num_sections; i++ )
+    {
+        const sc_ooo_table_section& s = sections[i];
+        if ( s.id >= SC_OOO_NUM_TABLES || seen[s.id] )
+            table_file_error( file_name, "bad or duplicate table id" );
+        if ( ( s.offset & 7 ) != 0 || s.offset + s.bytes > bytes )
+            table_file_error( file_name, "bad table offset" );
+        seen[s.id] = true;
+
+        switch ( s.id )
+        {
+            case SC_OOO_DATA_CONFLICT:
+                if ( s.rows != _OoO_Data_Conflict_Table_Size ||
+                     s.cols != _OoO_Data_Conflict_Table_Size )
+                    table_file_error( file_name, "table size mismatch" );
+                attach_section( _OoO_Data_Conflict_Matrix, s, base, false,
+                                raw[s.id], file_name );
+                break;
+            case SC_OOO_EVENT_NOTIFY:
+                if ( s.rows != _OoO_Event_Notify_Table_Size ||
+                     s.cols != _OoO_Event_Notify_Table_Size )
+                    table_file_error( file_name, "table size mismatch" );
+                attach_section( _OoO_Event_Notify_Matrix, s, base, false,
+                                raw[s.id], file_name );
+                break;
+            case SC_OOO_COMBINED_DATA_CONFLICT:
+                if ( s.rows != combined_table_dim() ||
+                     s.cols != combined_table_dim() )
+                    table_file_error( file_name, "table size mismatch" );
+                attach_section( _OoO_Combined_Data_Conflict_Matrix, s, base,
+                                true, raw[s.id], file_name );
+                break;
+            default:
+                if ( s.encoding != SC_OOO_TABLE_RAW || s.bytes != raw[s.id].bytes )
+                    table_file_error( file_name, "table size mismatch" );
+                std::memcpy( raw[s.id].data, base + s.offset, s.bytes );
+                break;
+        }
+    }
+
+    for ( int i = 0; i < SC_OOO_NUM_TABLES; i++ )
+        if ( !seen[i] )
+            table_file_error( file_name, "Not enough data in the table file" );
+
+    table_file_map = map;
+    table_file_bytes = bytes;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+//  FUNCTION : sc_ooo_attach_table_arrays
+// ----------------------------------------------------------------------------
+
+void
+sc_ooo_attach_table_arrays()
+{
+    _OoO_Data_Conflict_Matrix.attach_dense( _OoO_Data_Conflict_Table,
+        _OoO_Data_Conflict_Table_Size, _OoO_Data_Conflict_Table_Size );
+    _OoO_Event_Notify_Matrix.attach_dense( _OoO_Event_Notify_Table,
+        _OoO_Event_Notify_Table_Size, _OoO_Event_Notify_Table_Size );
+    _OoO_Combined_Data_Conflict_Matrix.attach_dense(
+        _OoO_Combined_Data_Conflict_Table,
+        combined_table_dim(), combined_table_dim() );
+}
+
+// ----------------------------------------------------------------------------
+//  FUNCTION : sc_ooo_write_table_file
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// one section of the file being written
+struct section_image {
+    sc_ooo_table_section  desc;
+    std::vector<char>     data;
+};
+
+template <class T>
+void
+append( std::vector<char>& out, const T* p, std::size_t n )
+{
+    const char* c = (const char*)p;
+    out.insert( out.end(), c, c + n * sizeof( T ) );
+}
+
+void
+pad8( std::vector<char>& out )
+{
+    out.resize( align8( out.size() ), 0 );
+}
+
+// encode a square matrix as BITS (boolean tables only) or CSR, whichever
+// is smaller
+void
+encode_matrix( section_image& img, const sc_ooo_matrix& m, bool is_int )
+{
+    std::size_t rows = m.rows(), cols = m.cols();
+    std::vector<uint64_t> row_ptr( 1, 0 );
+    std::vector<uint32_t> col_idx;
+    std::vector<int32_t>  values;
+    for ( std::size_t r = 0; r < rows; r++ )
+    {
+        for ( std::size_t c = 0; c < cols; c++ )
+        {
+            int v = m.get( r, c );
+            if ( v != 0 )
+            {
+                col_idx.push_back( (uint32_t)c );
+                values.push_back( v );
+            }
+        }
+        row_ptr.push_back( col_idx.size() );
+    }
+
+    std::size_t nnz = col_idx.size();
+    std::size_t words_per_row = ( cols + 63 ) / 64;
+    std::size_t bits_bytes = rows * words_per_row * sizeof( uint64_t );
+    std::size_t csr_bytes = ( rows + 1 ) * sizeof( uint64_t ) +
+                            align8( nnz * sizeof( uint32_t ) ) +
+                            ( is_int ? nnz * sizeof( int32_t ) : 0 );
+
+    img.desc.rows = rows;
+    img.desc.cols = cols;
+    img.desc.nnz = 0;
+    img.data.clear();
+
+    if ( !is_int && bits_bytes <= csr_bytes )
+    {
+        std::vector<uint64_t> words( rows * words_per_row, 0 );
+        for ( std::size_t r = 0; r < rows; r++ )
+            for ( uint64_t k = row_ptr[r]; k < row_ptr[r + 1]; k++ )
+                words[r * words_per_row + ( col_idx[k] >> 6 )] |=
+                    (uint64_t)1 << ( col_idx[k] & 63 );
+        img.desc.encoding = SC_OOO_TABLE_BITS;
+        append( img.data, words.empty() ? 0 : &words[0], words.size() );
+    }
+    else if ( is_int && rows * cols * sizeof( int ) <= csr_bytes )
+    {
+        // dense enough that the plain array is the smallest encoding
+        std::vector<int> dense( rows * cols );
+        for ( std::size_t r = 0; r < rows; r++ )
+            for ( std::size_t c = 0; c < cols; c++ )
+                dense[r * cols + c] = m.get( r, c );
+        img.desc.encoding = SC_OOO_TABLE_RAW;
+        append( img.data, dense.empty() ? 0 : &dense[0], dense.size() );
+    }
+    else
+    {
+        img.desc.encoding = SC_OOO_TABLE_CSR;
+        img.desc.nnz = nnz;
+        append( img.data, &row_ptr[0], row_ptr.size() );
+        append( img.data, col_idx.empty() ? 0 : &col_idx[0], nnz );
+        pad8( img.data );
+        if ( is_int )
+            append( img.data, values.empty() ? 0 : &values[0], nnz );
+    }
+    img.desc.bytes = img.data.size();
+}
+
+} // unnamed namespace
+
+void
+sc_ooo_write_table_file( const char* file_name )
+{
+    raw_table raw[SC_OOO_NUM_TABLES];
+    get_raw_tables( raw );
+
+    std::vector<section_image> images( SC_OOO_NUM_TABLES );
+    for ( int i = 0; i < SC_OOO_NUM_TABLES; i++ )
+    {
+        section_image& img = images[i];
+        std::memset( &img.desc, 0, sizeof( img.desc ) );
+        img.desc.id = i;
+        switch ( i )
+        {
+            case SC_OOO_DATA_CONFLICT:
+                encode_matrix( img, _OoO_Data_Conflict_Matrix, false );
+                break;
+            case SC_OOO_EVENT_NOTIFY:
+                encode_matrix( img, _OoO_Event_Notify_Matrix, false );
+                break;
+            case SC_OOO_COMBINED_DATA_CONFLICT:
+                encode_matrix( img, _OoO_Combined_Data_Conflict_Matrix, true );
+                break;
+            default:
+                img.desc.encoding = SC_OOO_TABLE_RAW;
+                img.desc.rows = raw[i].bytes;
+                img.desc.cols = 1;
+                append( img.data, (const char*)raw[i].data, raw[i].bytes );
+                img.desc.bytes = img.data.size();
+                break;
+        }
+    }
+
+    sc_ooo_table_header header;
+    std::memcpy( header.magic, SC_OOO_TABLE_MAGIC, 8 );
+    header.version = SC_OOO_TABLE_VERSION;
+    header.num_sections = SC_OOO_NUM_TABLES;
+
+    uint64_t offset = align8( sizeof( header ) +
+                              SC_OOO_NUM_TABLES * sizeof( sc_ooo_table_section ) );
+    for ( int i = 0; i < SC_OOO_NUM_TABLES; i++ )
+    {
+        images[i].desc.offset = offset;
+        offset = align8( offset + images[i].desc.bytes );
+    }
+
+    std::ofstream fout( file_name, std::ios::binary );
+    if ( !fout.good() )
+    {
+        std::cout << "Can't open the table file: " << file_name << std::endl;
+        exit(1);
+    }
+    std::vector<char> out;
+    append( out, &header, 1 );
+    for ( int i = 0; i < SC_OOO_NUM_TABLES; i++ )
+        append( out, &images[i].desc, 1 );
+    for ( int i = 0; i < SC_OOO_NUM_TABLES; i++ )
+    {
+        pad8( out );
+        out.insert( out.end(), images[i].data.begin(), images[i].data.end() );
+    }
+    fout.write( &out[0], out.size() );
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -0,0 +1,335 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_ooo_table.h -- Compact storage of the out-of-order scheduling tables and
+                    the versioned, memory-mapped table file format.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_OOO_TABLE_H
+#define SC_OOO_TABLE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace sc_core {
+
+/**
+ *  \brief Magic number and version of the packed table file.
+ *
+ *  A table file that does not start with this magic number is read in the
+ *  original format, i.e. all tables as raw arrays in a fixed order.
+ */
+#define SC_OOO_TABLE_MAGIC   "SCOOOTBL"
+#define SC_OOO_TABLE_VERSION 1
+
+/**
+ *  \brief Tables stored in a table file, in the order of the original
+ *         format.
+ */
+enum sc_ooo_table_id {
+    SC_OOO_DATA_CONFLICT = 0,
+    SC_OOO_EVENT_NOTIFY,
+    SC_OOO_CONFLICT_INDEX_LOOKUP,
+    SC_OOO_CURR_TIME_ADVANCE_TIME,
+    SC_OOO_CURR_TIME_ADVANCE_DELTA,
+    SC_OOO_NEXT_TIME_ADVANCE_TIME,
+    SC_OOO_NEXT_TIME_ADVANCE_DELTA,
+    SC_OOO_TIME_ADVANCE_INDEX_LOOKUP,
+    SC_OOO_COMBINED_DATA_CONFLICT,
+    SC_OOO_COMBINED_DATA_CONFLICT_LOOKUP,
+    SC_OOO_PREDICTION_TIME_ADVANCE_TIME_UNITS,
+    SC_OOO_PREDICTION_TIME_ADVANCE_DELTA,
+    SC_OOO_PREDICTION_TIME_ADVANCE_LOOKUP,
+    SC_OOO_PREDICTION_EVENT_NOTIFY_TIME_UNITS,
+    SC_OOO_PREDICTION_EVENT_NOTIFY_DELTA,
+    SC_OOO_PREDICTION_EVENT_NOTIFY_LOOKUP,
+    SC_OOO_NUM_TABLES
+};
+
+/**
+ *  \brief Encodings of a table section.
+ *
+ *  RAW is the plain array of the original format. BITS stores one bit per
+ *  entry, each row padded to a whole 64-bit word. CSR stores the row
+ *  offsets (uint64_t[rows+1]), the column of every non-zero entry
+ *  (uint32_t[nnz], padded to 8 bytes) and, for integer tables, its value
+ *  (int32_t[nnz]).
+ */
+enum sc_ooo_table_encoding {
+    SC_OOO_TABLE_RAW  = 0,
+    SC_OOO_TABLE_BITS = 1,
+    SC_OOO_TABLE_CSR  = 2
+};
+
+/**
+ *  \brief Header of a packed table file.
+ */
+struct sc_ooo_table_header {
+    char     magic[8];      // SC_OOO_TABLE_MAGIC, not 0-terminated
+    uint32_t version;       // SC_OOO_TABLE_VERSION
+    uint32_t num_sections;  // number of sc_ooo_table_section entries
+};
+
+/**
+ *  \brief Directory entry of one table in a packed table file. All offsets
+ *         are from the start of the file and 8-byte aligned.
+ */
+struct sc_ooo_table_section {
+    uint32_t id;            // sc_ooo_table_id
+    uint32_t encoding;      // sc_ooo_table_encoding
+    uint64_t rows;
+    uint64_t cols;          // 1 for the one-dimensional tables
+    uint64_t nnz;           // number of non-zero entries (CSR only)
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+/**************************************************************************//**
+ *  \class sc_ooo_matrix
+ *
+ *  \brief Read-only view of a square scheduling table, in whichever encoding
+ *         it was loaded. The storage is owned elsewhere (the table arrays of
+ *         the model or the mapped table file).
+ *****************************************************************************/
+
+class sc_ooo_matrix
+{
+public:
+
+    enum storage { NONE, DENSE_BOOL, DENSE_INT, BITS, CSR };
+
+    sc_ooo_matrix()
+        : m_storage( NONE ), m_rows( 0 ), m_cols( 0 ), m_words_per_row( 0 ),
+          m_bool( 0 ), m_int( 0 ), m_bits( 0 ), m_row_ptr( 0 ), m_col_idx( 0 ),
+          m_values( 0 )
+    {}
+
+    void attach_dense( const bool* table, std::size_t rows, std::size_t cols );
+    void attach_dense( const int* table, std::size_t rows, std::size_t cols );
+    void attach_bits( const uint64_t* words, std::size_t rows,
+                      std::size_t cols );
+    void attach_csr( const uint64_t* row_ptr, const uint32_t* col_idx,
+                     const int32_t* values, std::size_t rows,
+                     std::size_t cols );
+
+    /**
+     *  \brief The entry at (row, col), 0 if absent.
+     */
+    inline int get( std::size_t row, std::size_t col ) const;
+
+    /**
+     *  \brief Whether the entry at (row, col) is non-zero.
+     */
+    bool test( std::size_t row, std::size_t col ) const
+        { return get( row, col ) != 0; }
+
+    storage     get_storage() const { return m_storage; }
+    std::size_t rows() const { return m_rows; }
+    std::size_t cols() const { return m_cols; }
+
+    /**
+     *  \brief Number of bytes the table occupies in its current encoding.
+     */
+    std::size_t footprint() const;
+
+private:
+
+    friend class sc_ooo_conflict_filter;
+
+    storage         m_storage;
+    std::size_t     m_rows;
+    std::size_t     m_cols;
+    std::size_t     m_words_per_row;    // BITS
+    const bool*     m_bool;             // DENSE_BOOL
+    const int*      m_int;              // DENSE_INT
+    const uint64_t* m_bits;             // BITS
+    const uint64_t* m_row_ptr;          // CSR
+    const uint32_t* m_col_idx;          // CSR
+    const int32_t*  m_values;           // CSR, 0 for boolean tables
+};
+
+inline int
+sc_ooo_matrix::get( std::size_t row, std::size_t col ) const
+{
+    switch ( m_storage )
+    {
+        case DENSE_BOOL:
+            return m_bool[row * m_cols + col];
+        case DENSE_INT:
+            return m_int[row * m_cols + col];
+        case BITS:
+            return (int)( ( m_bits[row * m_words_per_row + ( col >> 6 )] >>
+                            ( col & 63 ) ) & 1 );
+        case CSR:
+        {
+            // binary search in the sorted column indices of the row
+            uint64_t lo = m_row_ptr[row];
+            uint64_t hi = m_row_ptr[row + 1];
+            while ( lo < hi )
+            {
+                uint64_t mid = lo + ( ( hi - lo ) >> 1 );
+                if ( m_col_idx[mid] < col )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if ( lo < m_row_ptr[row + 1] && m_col_idx[lo] == col )
+                return m_values ? m_values[lo] : 1;
+            return 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+/**************************************************************************//**
+ *  \class sc_ooo_conflict_filter
+ *
+ *  \brief Bitsets over the indices of the combined data conflict table.
+ *
+ *  For every index i, row i holds the indices j with a non-zero entry
+ *  (j, i), i.e. the segments that may conflict with segment i directly or
+ *  by prediction. The active set holds the indices of all processes that
+ *  have not finished. A segment whose row does not intersect the active
+ *  set cannot conflict with any process, whatever the timestamps are.
+ *****************************************************************************/
+
+class sc_ooo_conflict_filter
+{
+public:
+
+    sc_ooo_conflict_filter() : m_size( 0 ), m_words( 0 ) {}
+
+    /**
+     *  \brief Build the conflict rows from the combined data conflict table
+     *         and clear the active set.
+     */
+    void build( const sc_ooo_matrix& combined );
+
+    bool        is_built() const { return m_size != 0; }
+    std::size_t size() const { return m_size; }
+
+    /**
+     *  \brief Count one more (or one less) active process at index id.
+     */
+    void activate( int id );
+    void deactivate( int id );
+
+    /**
+     *  \brief Whether row id intersects the active set. self_id is the
+     *         index the tested process itself is counted at (or -1); it is
+     *         ignored unless another process shares it.
+     */
+    inline bool may_conflict( int id, int self_id ) const;
+
+private:
+
+    inline uint64_t intersect( const uint64_t* row ) const;
+
+private:
+
+    std::size_t                 m_size;     // number of indices
+    std::size_t                 m_words;    // 64-bit words per row
+    std::vector<uint64_t>       m_rows;     // m_size rows of m_words words
+    std::vector<uint64_t>       m_active;   // active set, m_words words
+    std::vector<unsigned int>   m_count;    // active processes per index
+};
+
+inline uint64_t
+sc_ooo_conflict_filter::intersect( const uint64_t* row ) const
+{
+    // no early exit, so that the loop can be vectorized
+    const uint64_t* active = &m_active[0];
+    uint64_t acc = 0;
+    for ( std::size_t w = 0; w < m_words; w++ )
+        acc |= row[w] & active[w];
+    return acc;
+}
+
+inline bool
+sc_ooo_conflict_filter::may_conflict( int id, int self_id ) const
+{
+    const uint64_t* row = &m_rows[(std::size_t)id * m_words];
+    if ( intersect( row ) == 0 )
+        return false;
+    if ( self_id < 0 || m_count[self_id] != 1 ||
+         !( ( row[self_id >> 6] >> ( self_id & 63 ) ) & 1 ) )
+        return true;
+
+    // the tested process may be the only hit
+    std::size_t w = self_id >> 6;
+    uint64_t self_bit = (uint64_t)1 << ( self_id & 63 );
+    if ( ( row[w] & m_active[w] & ~self_bit ) != 0 )
+        return true;
+    for ( std::size_t i = 0; i < m_words; i++ )
+        if ( i != w && ( row[i] & m_active[i] ) != 0 )
+            return true;
+    return false;
+}
+
+/**
+ *  \brief Views of the data conflict, event notification and combined data
+ *         conflict tables. The scheduler queries these instead of the raw
+ *         table arrays.
+ */
+extern sc_ooo_matrix _OoO_Data_Conflict_Matrix;
+extern sc_ooo_matrix _OoO_Event_Notify_Matrix;
+extern sc_ooo_matrix _OoO_Combined_Data_Conflict_Matrix;
+
+/**
+ *  \brief Map a packed table file and attach the table views to it.
+ *
+ *  Returns false if the file is not in the packed format, in which case the
+ *  caller reads it in the original format. Errors in a packed file are
+ *  fatal.
+ */
+bool sc_ooo_map_table_file( const char* file_name );
+
+/**
+ *  \brief Attach the table views to the table arrays of the model, after a
+ *         table file in the original format has been read.
+ */
+void sc_ooo_attach_table_arrays();
+
+/**
+ *  \brief Write the loaded tables as a packed table file, choosing BITS or
+ *         CSR for each of the three large tables by its density.
+ */
+void sc_ooo_write_table_file( const char* file_name );
+
+} // namespace sc_core
+
+#endif // SC_OOO_TABLE_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -610,7 +610,19 @@ sc_process_b::sc_process_b( const char* name_p, bool is_thread, bool free_host,
     cur_invoker_method_handle(NULL),
     PWT_defining_proc(NULL),
     prev_seg_id(-1),
-    group_no(-1)
+    group_no(-1),
+    m_conflict_filter_id(-1),
+    m_blocker_p(0),
+    m_blocker_time(),
+    m_blocker_state(-1),
+    m_blocker_seg_id(-1),
+    m_blocker_inst_id(-1),
+    m_parked_time(),
+    m_parked_seg_id(-1),
+    m_parked_epoch(0),
+    m_profile_index(-1),
+    m_wakeup_mark(0),
+    m_notify_posts()
 {
 
     // THIS OBJECT INSTANCE IS NOW THE LAST CREATED PROCESS:
@@ -633,6 +645,20 @@ sc_process_b::~sc_process_b()
 
     orphan_child_objects();
 
+    // NO LONGER COUNT THIS PROCESS AS ACTIVE:
+
+    if ( m_conflict_filter_id >= 0 )
+    {
+        m_process_state = 4;
+        simcontext()->update_conflict_filter( this );
+    }
+    simcontext()->unpark_all();
+
+    // APPLY THE NOTIFICATIONS IT POSTED, SO THE KERNEL DROPS ITS QUEUE:
+
+    if ( m_notify_posts.is_pending() )
+        simcontext()->drain_notifications();
+
 
     // DELETE SEMANTICS OBJECTS IF NEED BE:
 
@@ -670,24 +696,6 @@ sc_event& sc_process_b::terminated_event()
     return *m_term_event_p;
 }
 
-//------------------------------------------------------------------------------
-//"sc_process_b::lock_and_push"
-//
-//------------------------------------------------------------------------------
-void sc_process_b::lock_and_push( CHNL_MTX_TYPE_ *lock )
-{
-    m_acq_chnl_lock_queue.lock_and_push( lock );
-}
-
-//------------------------------------------------------------------------------
-//"sc_process_b::pop_and_unlock"
-//
-//------------------------------------------------------------------------------
-void sc_process_b::pop_and_unlock( CHNL_MTX_TYPE_ *lock )
-{
-    m_acq_chnl_lock_queue.pop_and_unlock( lock );
-}
-
 //------------------------------------------------------------------------------
 //"sc_process_b::lock_all_channels"
 //
@@ -729,6 +737,7 @@ void sc_process_b::set_segment_id( int id )
 {
     prev_seg_id = m_segment_id;
     m_segment_id = id;
+    simcontext()->update_conflict_filter( this );
 }
 
 //------------------------------------------------------------------------------
@@ -753,6 +762,7 @@ const sc_timestamp& sc_process_b::get_timestamp()
 void sc_process_b::set_timestamp( const sc_timestamp& ts )
 {
     m_timestamp = ts;
+    simcontext()->track_process( this );
 }
 
 //------------------------------------------------------------------------------
@@ -777,6 +787,7 @@ int sc_process_b::get_instance_id()
 void sc_process_b::set_instance_id( int id )
 {
     m_instance_id = id;
+    simcontext()->update_conflict_filter( this );
 }
 
 // +----------------------------------------------------------------------------
@@ -824,71 +835,6 @@ sc_process_handle::operator sc_thread_handle()
     return DCAST<sc_thread_handle>(m_target_p); 
 }
 
-//------------------------------------------------------------------------------
-//"sc_acq_chnl_lock_queue::lock_and_push"
-//
-// This method locks the channel lock and pushes it into the list.
-//------------------------------------------------------------------------------
-void sc_acq_chnl_lock_queue::lock_and_push( CHNL_MTX_TYPE_ *lock )
-{
-#ifdef FANCY_DEBUG
-    for ( std::list<sc_chnl_lock*>::iterator it=queue.begin(); 
-          it!=(queue.end()-1); it++ )
-    {
-         // 02/13/2015 GL: the new lock cannot be in the queue except at the 
-         //                last position
-         assert( lock != (*it)->lock_p ); 
-    }
-#endif
-
-    // 02/13/2015 GL: the new lock is not the same as the previous one
-    if ( queue.empty() || ( queue.back()->lock_p != lock ) )
-    {
-        CHNL_MTX_LOCK_( *lock );
-        sc_chnl_lock *chnl_lock = new sc_chnl_lock( lock );
-        queue.push_back( chnl_lock );
-    }
-    else // 02/13/2015 GL: the new lock is the same as the previous one
-    {
-#ifdef FANCY_DEBUG
-        assert( queue.back()->lock_p == lock );
-#endif
-        queue.back()->counter ++;
-    }
-}
-
-//------------------------------------------------------------------------------
-//"sc_acq_chnl_lock_queue::pop_and_unlock"
-//
-// This method pops the channel lock from the list and releases it.
-//------------------------------------------------------------------------------
-void sc_acq_chnl_lock_queue::pop_and_unlock( CHNL_MTX_TYPE_ *lock )
-{
-#ifdef FANCY_DEBUG
-    // 02/13/2015 GL: it is required to release the lock in the reverse order
-    assert( queue.back()->lock_p == lock );
-#endif
-
-    // 02/13/2015 GL: only one (or the last) instance of the lock is 
-    //                encountered
-    if ( queue.back()->counter == 1 )
-    {
-        sc_chnl_lock *chnl_lock = queue.back();
-        queue.pop_back();
-        delete chnl_lock;
-        CHNL_MTX_UNLOCK_( *lock );
-    }
-    // 02/13/2015 GL: more than one instances are encountered, and only to unlock
-    //                at the last instance
-    else
-    {
-        queue.back()->counter --;
-#ifdef FANCY_DEBUG
-        assert( queue.back()->counter >= 1 );
-#endif
-    }
-}
-
 //------------------------------------------------------------------------------
 //"sc_acq_chnl_lock_queue::lock_all"
 //
@@ -896,9 +842,8 @@ void sc_acq_chnl_lock_queue::pop_and_unlock( CHNL_MTX_TYPE_ *lock )
 //------------------------------------------------------------------------------
 void sc_acq_chnl_lock_queue::lock_all( void )
 {
-    for ( std::list<sc_chnl_lock*>::iterator it=queue.begin(); it!=queue.end(); 
-          it++ )
-        CHNL_MTX_LOCK_( *((*it)->lock_p) );
+    for ( std::size_t i = 0; i < m_size; i++ )
+        CHNL_MTX_LOCK_( *at( i ).lock_p );
 }
 
 //------------------------------------------------------------------------------
@@ -908,9 +853,8 @@ void sc_acq_chnl_lock_queue::lock_all( void )
 //------------------------------------------------------------------------------
 void sc_acq_chnl_lock_queue::unlock_all( void )
 {
-    for ( std::list<sc_chnl_lock*>::reverse_iterator it=queue.rbegin(); 
-          it!=queue.rend(); it++ )
-        CHNL_MTX_UNLOCK_( *((*it)->lock_p) );
+    for ( std::size_t i = m_size; i > 0; i-- )
+        CHNL_MTX_UNLOCK_( *at( i - 1 ).lock_p );
 }
 
 //------------------------------------------------------------------------------
@@ -320,10 +320,17 @@ class sc_throw_it : public sc_throw_it_helper
     EXCEPT m_value;  // value to be thrown.
 };
 
+/**
+ *  \brief Whether channel lock acquisitions are profiled, and the profiled
+ *         acquisition (see sc_profile).
+ */
+extern bool sc_profile_chnl_locks;
+void sc_profile_lock_chnl( CHNL_MTX_TYPE_ *lock );
+
 /**************************************************************************//**
  *  \class sc_acq_chnl_lock_queue
  *  
- *  \brief A list of channel locks acquired by a process.
+ *  \brief A stack of channel locks acquired by a process.
  *
  *  This class implements the object to maintain a list of channel locks  
  *  acquired in the hierachical channels. The outer channel lock is at the 
@@ -370,10 +377,23 @@ struct sc_chnl_lock {
      *  \brief The constructor initializes the lock pointer and counter.
      */
     sc_chnl_lock( CHNL_MTX_TYPE_ *m ): lock_p( m ), counter( 1 ) {}
+
+    /**
+     *  \brief An unused entry of the inline lock stack.
+     */
+    sc_chnl_lock(): lock_p( 0 ), counter( 0 ) {}
 };
 
 class sc_acq_chnl_lock_queue {
   public:
+    /**
+     *  \brief Number of channel locks kept inline; deeper nesting spills 
+     *         into a vector that keeps its capacity.
+     */
+    enum { INLINE_LOCKS = 8 };
+
+    sc_acq_chnl_lock_queue(): m_size( 0 ) {}
+
     /**
      *  \brief Acquire a new channel lock or increment the lock counter.
      *
@@ -386,7 +406,7 @@ class sc_acq_chnl_lock_queue {
      *  channel method calls an outer channel method), assertion fails and it
      *  stops the simulation. 
      */
-    void lock_and_push( CHNL_MTX_TYPE_ *lock );
+    inline void lock_and_push( CHNL_MTX_TYPE_ *lock );
 
     /**
      *  \brief Release a channel lock or decrement the lock counter.
@@ -398,7 +418,7 @@ class sc_acq_chnl_lock_queue {
      *  counter equals one, it pops the lock from the list and releases the 
      *  lock.
      */
-    void pop_and_unlock( CHNL_MTX_TYPE_ *lock );
+    inline void pop_and_unlock( CHNL_MTX_TYPE_ *lock );
 
     /**
      *  \brief Acquire all the channel locks in the list.
@@ -416,11 +436,92 @@ class sc_acq_chnl_lock_queue {
 
   private:
     /**
-     *  \brief A list of acquired channel locks.
+     *  \brief The i-th acquired channel lock, the outermost first.
+     */
+    sc_chnl_lock& at( std::size_t i )
+    {
+        return i < INLINE_LOCKS ? m_inline[i] : m_spill[i - INLINE_LOCKS];
+    }
+
+  private:
+    /**
+     *  \brief The stack of acquired channel locks: the first INLINE_LOCKS
+     *         in m_inline, the rest in m_spill.
      */
-    std::list<sc_chnl_lock*> queue;
+    std::size_t               m_size;
+    sc_chnl_lock              m_inline[INLINE_LOCKS];
+    std::vector<sc_chnl_lock> m_spill;
 };
 
+//------------------------------------------------------------------------------
+//"sc_acq_chnl_lock_queue::lock_and_push"
+//
+// This method locks the channel lock and pushes it onto the stack.
+//------------------------------------------------------------------------------
+inline void sc_acq_chnl_lock_queue::lock_and_push( CHNL_MTX_TYPE_ *lock )
+{
+#ifdef FANCY_DEBUG
+    for ( std::size_t i = 0; i + 1 < m_size; i++ )
+    {
+         // 02/13/2015 GL: the new lock cannot be in the queue except at the 
+         //                last position
+         assert( lock != at( i ).lock_p ); 
+    }
+#endif
+
+    // 02/13/2015 GL: the new lock is not the same as the previous one
+    if ( m_size == 0 || at( m_size - 1 ).lock_p != lock )
+    {
+        if ( SC_UNLIKELY_( sc_profile_chnl_locks ) )
+            sc_profile_lock_chnl( lock );
+        else
+            CHNL_MTX_LOCK_( *lock );
+        if ( m_size < INLINE_LOCKS )
+            m_inline[m_size] = sc_chnl_lock( lock );
+        else
+            m_spill.push_back( sc_chnl_lock( lock ) );
+        m_size++;
+    }
+    else // 02/13/2015 GL: the new lock is the same as the previous one
+    {
+        at( m_size - 1 ).counter ++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//"sc_acq_chnl_lock_queue::pop_and_unlock"
+//
+// This method pops the channel lock from the stack and releases it.
+//------------------------------------------------------------------------------
+inline void sc_acq_chnl_lock_queue::pop_and_unlock( CHNL_MTX_TYPE_ *lock )
+{
+    sc_chnl_lock& last = at( m_size - 1 );
+
+#ifdef FANCY_DEBUG
+    // 02/13/2015 GL: it is required to release the lock in the reverse order
+    assert( last.lock_p == lock );
+#endif
+
+    // 02/13/2015 GL: only one (or the last) instance of the lock is 
+    //                encountered
+    if ( last.counter == 1 )
+    {
+        m_size--;
+        if ( m_size >= INLINE_LOCKS )
+            m_spill.pop_back();
+        CHNL_MTX_UNLOCK_( *lock );
+    }
+    // 02/13/2015 GL: more than one instances are encountered, and only to unlock
+    //                at the last instance
+    else
+    {
+        last.counter --;
+#ifdef FANCY_DEBUG
+        assert( last.counter >= 1 );
+#endif
+    }
+}
+
 /**************************************************************************//**
  *  \class sc_timestamp
  *
@@ -532,6 +633,90 @@ private:
     bool       m_infinite;
 };
 
+/**************************************************************************//**
+ *  \class sc_notify_post_queue
+ *
+ *  \brief The notifications a running process posted without the kernel
+ *         lock and the kernel has not applied yet (see
+ *         sc_simcontext::post_notification).
+ *
+ *  The process is the only producer and the holder of the kernel lock the
+ *  only consumer, so the ring needs no lock. When it is full, the process
+ *  takes the kernel lock instead of posting.
+ *****************************************************************************/
+
+class sc_notify_post_queue {
+  public:
+    /**
+     *  \brief Number of notifications kept in the ring.
+     */
+    enum { POSTS = 8 };
+
+    struct post {
+        sc_event*    m_event_p;
+        sc_timestamp m_proc_ts; // local time of the process at the post
+        sc_time      m_delay;
+    };
+
+    sc_notify_post_queue(): m_head( 0 ), m_tail( 0 ), m_pending( false ),
+                            m_next_p( 0 ) {}
+
+    /**
+     *  \brief Append a notification, by the process. Returns false if the
+     *         ring is full.
+     */
+    inline bool push( sc_event* event_p, const sc_timestamp& proc_ts,
+                      const sc_time& delay );
+
+    /**
+     *  \brief The oldest notification not applied yet, or 0; by the kernel.
+     */
+    inline const post* front() const;
+
+    /**
+     *  \brief Release the entry of front(), by the kernel.
+     */
+    void pop() { __atomic_store_n( &m_head, m_head + 1, __ATOMIC_RELEASE ); }
+
+    /**
+     *  \brief Whether the process is on the kernel's list of processes with
+     *         posts.
+     */
+    bool is_pending() const
+        { return __atomic_load_n( &m_pending, __ATOMIC_ACQUIRE ); }
+
+  private:
+    friend class sc_simcontext;
+
+    post          m_posts[POSTS];
+    unsigned int  m_head;     // next entry to apply
+    unsigned int  m_tail;     // next entry to fill
+    bool          m_pending;  // on the list of processes with posts
+    sc_process_b* m_next_p;   // next process on that list
+};
+
+inline bool
+sc_notify_post_queue::push( sc_event* event_p, const sc_timestamp& proc_ts,
+                            const sc_time& delay )
+{
+    if ( m_tail - __atomic_load_n( &m_head, __ATOMIC_ACQUIRE ) == POSTS )
+        return false;
+    post& entry = m_posts[m_tail % POSTS];
+    entry.m_event_p = event_p;
+    entry.m_proc_ts = proc_ts;
+    entry.m_delay = delay;
+    __atomic_store_n( &m_tail, m_tail + 1, __ATOMIC_RELEASE );
+    return true;
+}
+
+inline const sc_notify_post_queue::post*
+sc_notify_post_queue::front() const
+{
+    if ( m_head == __atomic_load_n( &m_tail, __ATOMIC_ACQUIRE ) )
+        return 0;
+    return &m_posts[m_head % POSTS];
+}
+
 bool heap_cmp(sc_process_b*& s, sc_process_b*& t); //DM 08/15/2019 for event delivery
 
 /**************************************************************************//**
@@ -754,7 +939,7 @@ class sc_process_b : public sc_object {
      *  corresponding channel lock in the list.
      */
     // 02/16/2015 GL.
-    void lock_and_push( CHNL_MTX_TYPE_ *lock );
+    inline void lock_and_push( CHNL_MTX_TYPE_ *lock );
 
     /**
      *  \brief Release a channel lock or decrement the lock counter.
@@ -763,7 +948,7 @@ class sc_process_b : public sc_object {
      *  if its lock counter equals one, or decrement its lock counter.
      */
     // 02/16/2015 GL.
-    void pop_and_unlock( CHNL_MTX_TYPE_ *lock );
+    inline void pop_and_unlock( CHNL_MTX_TYPE_ *lock );
 
     /**
      *  \brief Acquire all the channel locks.
@@ -972,6 +1157,28 @@ class sc_process_b : public sc_object {
     int get_previous_seg_id();
     int group_no;
 
+  public:
+    int m_conflict_filter_id; // index this process is counted at in the
+                              // conflict filter, -1 if not counted
+
+    // the process this ready process is parked on after a failed conflict
+    // check, and the state of both at that time (see sc_simcontext::park)
+    sc_process_b* m_blocker_p;
+    sc_timestamp  m_blocker_time;   // timestamp, wake-up time if waiting
+    int           m_blocker_state;
+    int           m_blocker_seg_id;
+    int           m_blocker_inst_id;
+    sc_timestamp  m_parked_time;
+    int           m_parked_seg_id;
+    unsigned int  m_parked_epoch;
+
+    int m_profile_index; // entry of this process in the scheduler profile,
+                         // -1 if none yet
+
+    unsigned int m_wakeup_mark; // see sc_simcontext::push_waiting_before
+
+    sc_notify_post_queue m_notify_posts; // notifications posted without
+                                         // the kernel lock
 };
 
 typedef sc_process_b sc_process_b;  // For compatibility.
@@ -1011,6 +1218,24 @@ sc_process_b::get_child_objects() const
 }
 
 
+//------------------------------------------------------------------------------
+//"sc_process_b::lock_and_push"
+//
+//------------------------------------------------------------------------------
+inline void sc_process_b::lock_and_push( CHNL_MTX_TYPE_ *lock )
+{
+    m_acq_chnl_lock_queue.lock_and_push( lock );
+}
+
+//------------------------------------------------------------------------------
+//"sc_process_b::pop_and_unlock"
+//
+//------------------------------------------------------------------------------
+inline void sc_process_b::pop_and_unlock( CHNL_MTX_TYPE_ *lock )
+{
+    m_acq_chnl_lock_queue.pop_and_unlock( lock );
+}
+
 //------------------------------------------------------------------------------
 //"sc_process_b::initially_in_reset"
 //
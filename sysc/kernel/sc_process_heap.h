@@ -0,0 +1,145 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_process_heap.h -- Min-heap of processes keyed on their time stamps, for
+                       the synchronized parallel simulation.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_PROCESS_HEAP_H
+#define SC_PROCESS_HEAP_H
+
+#include "sysc/kernel/sc_process.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace sc_core {
+
+// an entry of sc_process_heap
+struct sc_process_heap_entry {
+    sc_timestamp        ts;
+    unsigned long long  seq;    // push order, breaks ties
+    sc_process_b*       proc_p;
+};
+
+/**************************************************************************//**
+ *  \class sc_process_heap
+ *
+ *  \brief A min-heap of processes, the earliest time stamp on top, and
+ *         among equal time stamps the one pushed first.
+ *
+ *  An entry keeps the time stamp the process had when it was pushed. The
+ *  heap does not follow later changes; a user that needs the current state
+ *  pushes the process again on every change and drops the outdated
+ *  entries when they reach the top (see sc_simcontext::earliest_process).
+ *****************************************************************************/
+
+class sc_process_heap
+{
+public:
+
+    typedef sc_process_heap_entry entry;
+
+    sc_process_heap() : m_seq( 0 ) {}
+
+    bool        empty() const { return m_heap.empty(); }
+    std::size_t size() const { return m_heap.size(); }
+
+    const entry& top() const { return m_heap.front(); }
+
+    void push( sc_process_b* proc_p, const sc_timestamp& ts )
+    {
+        entry e;
+        e.ts = ts;
+        e.seq = m_seq++;
+        e.proc_p = proc_p;
+        m_heap.push_back( e );
+        std::push_heap( m_heap.begin(), m_heap.end(), later );
+    }
+
+    void pop()
+    {
+        std::pop_heap( m_heap.begin(), m_heap.end(), later );
+        m_heap.pop_back();
+    }
+
+    void clear() { m_heap.clear(); }
+
+    /**
+     *  \brief Append the entries earlier than ts, in no particular order.
+     *
+     *  The entries are laid out as a binary heap (the children of entry i
+     *  are 2i+1 and 2i+2), so the children of an entry that is not earlier
+     *  than ts are skipped.
+     */
+    void collect_earlier( const sc_timestamp& ts,
+                          std::vector<const entry*>& entries ) const
+    {
+        if ( m_heap.empty() || !( m_heap.front().ts < ts ) )
+            return;
+        std::size_t k = entries.size();
+        entries.push_back( &m_heap.front() );
+        for ( ; k < entries.size(); k++ )
+        {
+            std::size_t child = 2 * ( entries[k] - &m_heap.front() ) + 1;
+            for ( std::size_t end = child + 2;
+                  child < end && child < m_heap.size(); child++ )
+            {
+                if ( m_heap[child].ts < ts )
+                    entries.push_back( &m_heap[child] );
+            }
+        }
+    }
+
+private:
+
+    // the heap functions keep the greatest element on top, so order by
+    // "comes later"
+    static bool later( const entry& a, const entry& b )
+    {
+        if ( a.ts == b.ts )
+            return a.seq > b.seq;
+        return b.ts < a.ts;
+    }
+
+private:
+
+    std::vector<entry>  m_heap;
+    unsigned long long  m_seq;
+};
+
+} // namespace sc_core
+
+#endif // SC_PROCESS_HEAP_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
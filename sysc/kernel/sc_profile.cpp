@@ -0,0 +1,412 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_profile.cpp -- Profiling of the out-of-order scheduler: run time and
+                    conflicts per process and per segment, and lock
+                    statistics.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_profile.h"
+#include "sysc/kernel/sc_process.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  Channel locks.
+// ----------------------------------------------------------------------------
+
+bool sc_profile_chnl_locks = false;
+
+// updated by all simulation threads
+static unsigned long long sc_chnl_acquisitions = 0;
+static unsigned long long sc_chnl_contended = 0;
+static unsigned long long sc_chnl_wait_cycles = 0;
+
+static inline unsigned long long
+sc_profile_cycles()
+{
+    unsigned long long hi, lo;
+    __asm__ __volatile__ ( "rdtsc" : "=a"(lo), "=d"(hi) );
+    return lo | ( hi << 32 );
+}
+
+// take the fast path first, and only time the acquisition if another
+// thread currently holds the lock
+
+void
+sc_profile_lock_chnl( CHNL_MTX_TYPE_ *lock )
+{
+    __atomic_fetch_add( &sc_chnl_acquisitions, 1, __ATOMIC_RELAXED );
+    if ( CHNL_MTX_TRYLOCK_( *lock ) )
+        return;
+
+    unsigned long long start_cycles = sc_profile_cycles();
+    CHNL_MTX_LOCK_( *lock );
+    __atomic_fetch_add( &sc_chnl_contended, 1, __ATOMIC_RELAXED );
+    __atomic_fetch_add( &sc_chnl_wait_cycles,
+                        sc_profile_cycles() - start_cycles, __ATOMIC_RELAXED );
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_profile
+// ----------------------------------------------------------------------------
+
+sc_profile::sc_profile()
+    : m_kernel_lock_since( 0 )
+{
+    __atomic_store_n( &sc_chnl_acquisitions, 0, __ATOMIC_RELAXED );
+    __atomic_store_n( &sc_chnl_contended, 0, __ATOMIC_RELAXED );
+    __atomic_store_n( &sc_chnl_wait_cycles, 0, __ATOMIC_RELAXED );
+    sc_profile_chnl_locks = true;
+}
+
+sc_profile::~sc_profile()
+{
+    sc_profile_chnl_locks = false;
+}
+
+const char*
+sc_profile::file_name()
+{
+    const char* env = std::getenv( _SYSC_PROFILE_ENV_VAR );
+    return env != NULL && *env != 0 ? env : 0;
+}
+
+int
+sc_profile::index_of( sc_process_b* process_h )
+{
+    int index = process_h->m_profile_index;
+    if ( index >= 0 && index < (int)m_processes.size() )
+        return index;
+
+    index = m_processes.size();
+    m_processes.push_back( sc_profile_process() );
+    m_processes.back().name = process_h->name();
+    m_processes.back().inst_id = process_h->get_instance_id();
+    m_states.push_back( state() );
+    process_h->m_profile_index = index;
+    return index;
+}
+
+// charge the time since the current blocker took over to its segment pair
+
+void
+sc_profile::charge_blocker( int index, unsigned long long now )
+{
+    state& st = m_states[index];
+    sc_profile_conflict& pair =
+        m_conflicts[std::make_pair( st.blocked_seg_id, st.blocker_seg_id )];
+    pair.blocked_cycles += now - st.blocker_since;
+}
+
+void
+sc_profile::issued( sc_process_b* process_h, unsigned long long now )
+{
+    int index = index_of( process_h );
+    state& st = m_states[index];
+    sc_profile_process& proc = m_processes[index];
+
+    if ( st.blocked )
+    {
+        charge_blocker( index, now );
+        proc.blocked_cycles += now - st.blocked_since;
+        m_segments[st.blocked_seg_id].blocked_cycles +=
+            now - st.blocked_since;
+        st.blocked = false;
+    }
+
+    st.running = true;
+    st.run_seg_id = process_h->get_segment_id();
+    st.issue_cycles = now;
+    proc.issues++;
+    m_segments[st.run_seg_id].issues++;
+}
+
+void
+sc_profile::finished( sc_process_b* process_h, unsigned long long now )
+{
+    int index = process_h->m_profile_index;
+    if ( index < 0 || index >= (int)m_states.size() ||
+         !m_states[index].running )
+        return;
+
+    state& st = m_states[index];
+    unsigned long long run_cycles = now - st.issue_cycles;
+    m_processes[index].run_cycles += run_cycles;
+    m_segments[st.run_seg_id].run_cycles += run_cycles;
+    st.running = false;
+}
+
+void
+sc_profile::blocked( sc_process_b* process_h, int blocker_seg_id,
+                     unsigned long long now )
+{
+    int index = index_of( process_h );
+    state& st = m_states[index];
+
+    if ( !st.blocked )
+    {
+        st.blocked = true;
+        st.blocked_seg_id = process_h->get_segment_id();
+        st.blocked_since = now;
+        m_processes[index].blocked++;
+        m_segments[st.blocked_seg_id].blocked++;
+    }
+    else if ( blocker_seg_id != st.blocker_seg_id )
+        charge_blocker( index, now );
+    else
+        return; // still held back by the same segment
+
+    st.blocker_seg_id = blocker_seg_id;
+    st.blocker_since = now;
+    sc_profile_conflict& pair =
+        m_conflicts[std::make_pair( st.blocked_seg_id, blocker_seg_id )];
+    pair.seg_id = st.blocked_seg_id;
+    pair.blocker_seg_id = blocker_seg_id;
+    pair.blocked++;
+}
+
+void
+sc_profile::kernel_lock_acquired( bool contended,
+                                  unsigned long long wait_cycles,
+                                  unsigned long long now )
+{
+    m_kernel_lock.acquisitions++;
+    if ( contended )
+    {
+        m_kernel_lock.contended++;
+        m_kernel_lock.wait_cycles += wait_cycles;
+    }
+    m_kernel_lock_since = now;
+}
+
+void
+sc_profile::kernel_lock_released( unsigned long long now )
+{
+    m_kernel_lock.hold_cycles += now - m_kernel_lock_since;
+}
+
+static bool
+sc_longer_blocked( const sc_profile_conflict& a, const sc_profile_conflict& b )
+{
+    return a.blocked_cycles > b.blocked_cycles;
+}
+
+std::vector<sc_profile_conflict>
+sc_profile::conflicts() const
+{
+    std::vector<sc_profile_conflict> result;
+    result.reserve( m_conflicts.size() );
+    for ( std::map<std::pair<int, int>, sc_profile_conflict>::const_iterator
+              it = m_conflicts.begin(); it != m_conflicts.end(); it++ )
+        result.push_back( it->second );
+    std::stable_sort( result.begin(), result.end(), sc_longer_blocked );
+    return result;
+}
+
+sc_profile_lock
+sc_profile::channel_locks() const
+{
+    sc_profile_lock result;
+    result.acquisitions =
+        __atomic_load_n( &sc_chnl_acquisitions, __ATOMIC_RELAXED );
+    result.contended = __atomic_load_n( &sc_chnl_contended, __ATOMIC_RELAXED );
+    result.wait_cycles =
+        __atomic_load_n( &sc_chnl_wait_cycles, __ATOMIC_RELAXED );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+//  Output.
+// ----------------------------------------------------------------------------
+
+static void
+sc_write_json_string( std::ostream& os, const std::string& str )
+{
+    static const char hex[] = "0123456789abcdef";
+    os << '"';
+    for ( std::string::size_type i = 0; i < str.size(); i++ )
+    {
+        unsigned char c = str[i];
+        if ( c == '"' || c == '\\' )
+            os << '\\' << c;
+        else if ( c < 0x20 )
+            os << "\\u00" << hex[c >> 4] << hex[c & 15];
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+static void
+sc_write_json_counters( std::ostream& os, const sc_profile_counters& c )
+{
+    os << "\"issues\": " << c.issues
+       << ", \"run_cycles\": " << c.run_cycles
+       << ", \"blocked\": " << c.blocked
+       << ", \"blocked_cycles\": " << c.blocked_cycles;
+}
+
+static void
+sc_write_json_lock( std::ostream& os, const sc_profile_lock& l )
+{
+    os << "{\"acquisitions\": " << l.acquisitions
+       << ", \"contended\": " << l.contended
+       << ", \"wait_cycles\": " << l.wait_cycles
+       << ", \"hold_cycles\": " << l.hold_cycles << "}";
+}
+
+void
+sc_profile::write_json( std::ostream& os ) const
+{
+    os << "{\n  \"processes\": [";
+    for ( unsigned int i = 0; i < m_processes.size(); i++ )
+    {
+        os << ( i ? ",\n" : "\n" ) << "    {\"name\": ";
+        sc_write_json_string( os, m_processes[i].name );
+        os << ", \"instance\": " << m_processes[i].inst_id << ", ";
+        sc_write_json_counters( os, m_processes[i] );
+        os << "}";
+    }
+
+    os << "\n  ],\n  \"segments\": [";
+    for ( std::map<int, sc_profile_counters>::const_iterator
+              it = m_segments.begin(); it != m_segments.end(); it++ )
+    {
+        os << ( it != m_segments.begin() ? ",\n" : "\n" )
+           << "    {\"segment\": " << it->first << ", ";
+        sc_write_json_counters( os, it->second );
+        os << "}";
+    }
+
+    std::vector<sc_profile_conflict> pairs = conflicts();
+    os << "\n  ],\n  \"conflicts\": [";
+    for ( unsigned int i = 0; i < pairs.size(); i++ )
+    {
+        os << ( i ? ",\n" : "\n" )
+           << "    {\"segment\": " << pairs[i].seg_id
+           << ", \"blocker_segment\": " << pairs[i].blocker_seg_id
+           << ", \"blocked\": " << pairs[i].blocked
+           << ", \"blocked_cycles\": " << pairs[i].blocked_cycles << "}";
+    }
+
+    os << "\n  ],\n  \"kernel_lock\": ";
+    sc_write_json_lock( os, m_kernel_lock );
+    os << ",\n  \"channel_locks\": ";
+    sc_write_json_lock( os, channel_locks() );
+    os << "\n}\n";
+}
+
+// one table; the columns that do not apply to a row are left empty
+
+static void
+sc_write_csv_counters( std::ostream& os, const sc_profile_counters& c )
+{
+    os << c.issues << "," << c.run_cycles << "," << c.blocked << ","
+       << c.blocked_cycles << ",,,,";
+}
+
+static void
+sc_write_csv_lock( std::ostream& os, const char* kind,
+                   const sc_profile_lock& l )
+{
+    os << kind << ",,,,,,,,," << l.acquisitions << "," << l.contended << ","
+       << l.wait_cycles << "," << l.hold_cycles << "\n";
+}
+
+void
+sc_profile::write_csv( std::ostream& os ) const
+{
+    os << "kind,name,instance,segment,blocker_segment,issues,run_cycles,"
+          "blocked,blocked_cycles,acquisitions,contended,wait_cycles,"
+          "hold_cycles\n";
+
+    for ( unsigned int i = 0; i < m_processes.size(); i++ )
+    {
+        // quote the name, doubling any quotes in it
+        const std::string& name = m_processes[i].name;
+        os << "process,\"";
+        for ( std::string::size_type c = 0; c < name.size(); c++ )
+            os << ( name[c] == '"' ? "\"\"" : std::string( 1, name[c] ) );
+        os << "\"," << m_processes[i].inst_id << ",,,";
+        sc_write_csv_counters( os, m_processes[i] );
+        os << "\n";
+    }
+
+    for ( std::map<int, sc_profile_counters>::const_iterator
+              it = m_segments.begin(); it != m_segments.end(); it++ )
+    {
+        os << "segment,,," << it->first << ",,";
+        sc_write_csv_counters( os, it->second );
+        os << "\n";
+    }
+
+    std::vector<sc_profile_conflict> pairs = conflicts();
+    for ( unsigned int i = 0; i < pairs.size(); i++ )
+    {
+        os << "conflict,,," << pairs[i].seg_id << ","
+           << pairs[i].blocker_seg_id << ",,," << pairs[i].blocked
+           << "," << pairs[i].blocked_cycles << ",,,,\n";
+    }
+
+    sc_write_csv_lock( os, "kernel_lock", m_kernel_lock );
+    sc_write_csv_lock( os, "channel_locks", channel_locks() );
+}
+
+void
+sc_profile::write( const char* file_name ) const
+{
+    std::ofstream os( file_name );
+    if ( !os )
+    {
+        std::cout << "Cannot write the profile to " << file_name
+                  << std::endl;
+        return;
+    }
+
+    std::size_t len = std::strlen( file_name );
+    if ( len >= 4 && std::strcmp( file_name + len - 4, ".csv" ) == 0 )
+        write_csv( os );
+    else
+        write_json( os );
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -0,0 +1,227 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_profile.h -- Profiling of the out-of-order scheduler: run time and
+                  conflicts per process and per segment, and lock statistics.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_PROFILE_H
+#define SC_PROFILE_H
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sc_core {
+
+class sc_process_b;
+
+/**
+ *  \brief Environment variable naming the profile file. The profile is
+ *         only recorded if it is set. A name ending in ".csv" selects CSV,
+ *         any other name JSON.
+ */
+#ifndef _SYSC_PROFILE_ENV_VAR
+#define _SYSC_PROFILE_ENV_VAR "SYSC_PROFILE"
+#endif
+
+/**
+ *  \brief The blocker segment of a process that had no conflict, but was
+ *         not issued because no invoker was idle.
+ */
+#define SC_PROFILE_NO_INVOKER -1
+
+/**
+ *  \brief Counters kept per process and per segment. All times are in
+ *         CPU cycles (rdtsc).
+ */
+struct sc_profile_counters {
+    unsigned long long issues;          // times issued to run
+    unsigned long long run_cycles;      // from issue to suspension
+    unsigned long long blocked;         // times held back while ready
+    unsigned long long blocked_cycles;  // from held back to issued
+
+    sc_profile_counters()
+        : issues( 0 ), run_cycles( 0 ), blocked( 0 ), blocked_cycles( 0 ) {}
+};
+
+/**
+ *  \brief Counters of one process. A segment is charged with the run time
+ *         of the segment the process was issued in.
+ */
+struct sc_profile_process : public sc_profile_counters {
+    std::string name;
+    int         inst_id;
+
+    sc_profile_process() : inst_id( -1 ) {}
+};
+
+/**
+ *  \brief How often, and for how long, processes in one segment were held
+ *         back by a process in another one. blocker_seg_id is
+ *         SC_PROFILE_NO_INVOKER if all invokers were busy.
+ */
+struct sc_profile_conflict {
+    int                seg_id;
+    int                blocker_seg_id;
+    unsigned long long blocked;         // times the blocker took over
+    unsigned long long blocked_cycles;
+
+    sc_profile_conflict()
+        : seg_id( -1 ), blocker_seg_id( -1 ), blocked( 0 ),
+          blocked_cycles( 0 ) {}
+};
+
+/**
+ *  \brief Counters of the kernel lock, or of all channel locks together.
+ *         Channel locks have no hold time.
+ */
+struct sc_profile_lock {
+    unsigned long long acquisitions;
+    unsigned long long contended;       // the lock was not free
+    unsigned long long wait_cycles;     // waiting for contended acquisitions
+    unsigned long long hold_cycles;
+
+    sc_profile_lock()
+        : acquisitions( 0 ), contended( 0 ), wait_cycles( 0 ),
+          hold_cycles( 0 ) {}
+};
+
+/**************************************************************************//**
+ *  \class sc_profile
+ *
+ *  \brief Statistics of the out-of-order scheduler, recorded while
+ *         _SYSC_PROFILE_ENV_VAR is set, written at the end of simulation
+ *         and available through sc_simcontext::get_profile().
+ *
+ *  Blocking is counted from the first failed issue of a process after it
+ *  became ready until it is issued, and charged to the segment of the
+ *  process that blocked it: a process blocked first by one and then by
+ *  another segment is charged to both pairs, each for its own part.
+ *
+ *  All recording functions except the channel lock ones are called with
+ *  the kernel lock held.
+ *****************************************************************************/
+
+class sc_profile
+{
+public:
+
+    sc_profile();
+    ~sc_profile();
+
+    // recording, called by the scheduler
+
+    void issued( sc_process_b* process_h, unsigned long long now );
+    void finished( sc_process_b* process_h, unsigned long long now );
+    void blocked( sc_process_b* process_h, int blocker_seg_id,
+                  unsigned long long now );
+    void kernel_lock_acquired( bool contended, unsigned long long wait_cycles,
+                               unsigned long long now );
+    void kernel_lock_released( unsigned long long now );
+
+    // queries
+
+    const std::vector<sc_profile_process>& processes() const
+        { return m_processes; }
+    const std::map<int, sc_profile_counters>& segments() const
+        { return m_segments; }
+
+    /**
+     *  \brief The segment pairs, the longest blocked first.
+     */
+    std::vector<sc_profile_conflict> conflicts() const;
+
+    const sc_profile_lock& kernel_lock() const { return m_kernel_lock; }
+    sc_profile_lock channel_locks() const;
+
+    /**
+     *  \brief Write the profile to file_name, as CSV if the name ends in
+     *         ".csv" and as JSON otherwise.
+     */
+    void write( const char* file_name ) const;
+
+    /**
+     *  \brief The file named by _SYSC_PROFILE_ENV_VAR, or 0.
+     */
+    static const char* file_name();
+
+private:
+
+    // scheduling state of one process, parallel to m_processes
+    struct state {
+        bool               running;
+        int                run_seg_id;      // segment at issue
+        unsigned long long issue_cycles;
+        bool               blocked;
+        int                blocked_seg_id;  // segment when held back
+        int                blocker_seg_id;
+        unsigned long long blocked_since;
+        unsigned long long blocker_since;   // current blocker took over
+
+        state()
+            : running( false ), run_seg_id( -1 ), issue_cycles( 0 ),
+              blocked( false ), blocked_seg_id( -1 ),
+              blocker_seg_id( SC_PROFILE_NO_INVOKER ), blocked_since( 0 ),
+              blocker_since( 0 ) {}
+    };
+
+    int  index_of( sc_process_b* process_h );
+    void charge_blocker( int index, unsigned long long now );
+
+    void write_json( std::ostream& os ) const;
+    void write_csv( std::ostream& os ) const;
+
+private:
+
+    std::vector<sc_profile_process>                   m_processes;
+    std::vector<state>                                m_states;
+    std::map<int, sc_profile_counters>                m_segments;
+    std::map<std::pair<int, int>, sc_profile_conflict> m_conflicts;
+    sc_profile_lock                                   m_kernel_lock;
+    unsigned long long                                m_kernel_lock_since;
+
+private:
+
+    // disabled
+    sc_profile( const sc_profile& );
+    sc_profile& operator = ( const sc_profile& );
+};
+
+} // namespace sc_core
+
+#endif // SC_PROFILE_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
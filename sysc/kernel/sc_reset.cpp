@@ -137,6 +137,17 @@ void sc_reset::notify_processes()
     std::vector<sc_reset_target>::size_type process_n;    // # of processes to reset.
     bool                                    value;        // value of our signal.
 
+    // deferred like the event notifications of a parallel update thread
+    if ( SC_UNLIKELY_( sc_deferred_updates_p != 0 ) )
+    {
+        sc_deferred_update deferred;
+        deferred.m_event_p = 0;
+        deferred.m_reset_p = this;
+        deferred.m_delay = SC_ZERO_TIME;
+        sc_deferred_updates_p->push_back( deferred );
+        return;
+    }
+
     value = m_iface_p->read();
     process_n = m_targets.size();
     for ( process_i = 0; process_i < process_n; process_i++ )
@@ -31,6 +31,7 @@
 #define SC_DISABLE_API_VERSION_CHECK // for in-library sc_ver.h inclusion
 
 #include "sysc/kernel/sc_cor_fiber.h"
+#include "sysc/kernel/sc_cor_pool.h"
 #include "sysc/kernel/sc_cor_pthread.h"
 #include "sysc/kernel/sc_cor_qt.h"
 #include "sysc/kernel/sc_event.h"
@@ -39,6 +40,11 @@
 #include "sysc/kernel/sc_module_registry.h"
 #include "sysc/kernel/sc_name_gen.h"
 #include "sysc/kernel/sc_object_manager.h"
+#include "sysc/kernel/sc_affinity.h"
+#include "sysc/kernel/sc_profile.h"
+#include "sysc/kernel/sc_issue_log.h"
+#include "sysc/kernel/sc_process_heap.h"
+#include "sysc/kernel/sc_ooo_table.h"
 #include "sysc/kernel/sc_cthread_process.h"
 #include "sysc/kernel/sc_method_process.h"
 #include "sysc/kernel/sc_thread_process.h"
@@ -60,6 +66,7 @@
 
 #include <string>
 #include <set>
+#include <deque>
 #include <map> // 09/02/2015 GL: to include std::map for index lookup
 #include <unordered_map>
 #include <math.h>
@@ -141,6 +148,11 @@
 #define _SYSC_PRINT_MODE_MESSAGE_ENV_VAR "SYSC_PRINT_MODE_MESSAGE"
 #endif
 
+// name of a file to write the loaded tables to in the packed format
+#ifndef _SYSC_WRITE_PACKED_TABLE_FILE_ENV_VAR
+#define _SYSC_WRITE_PACKED_TABLE_FILE_ENV_VAR "SYSC_WRITE_PACKED_TABLE_FILE"
+#endif
+
 // 03/22/2019 ZC : add environmental variables for debugging logs
 #ifndef _SYSC_VERBOSITY_FLAG_1
 #define _SYSC_VERBOSITY_FLAG_1 "SYSC_VERBOSITY_FLAG_1"
@@ -194,6 +206,13 @@ static inline cycles_t currentcycles( void )
     return (lo | (hi << 32));
 }
 
+//order ready processes by their local timestamp
+template<class T>
+static inline bool sc_ready_time_compare( T a, T b )
+{
+    return a->get_timestamp() < b->get_timestamp();
+}
+
 class Invoker : public sc_module {
 
     friend class sc_simcontext;
@@ -201,31 +220,118 @@ class Invoker : public sc_module {
     void method_invoker();
     void suspend_invoker();
 
+    /**
+     *  \brief Queue a batch of issued methods on this invoker.
+     */
+    void push_methods( std::vector<sc_process_b*>::const_iterator first,
+                       std::vector<sc_process_b*>::const_iterator last );
+
+    /**
+     *  \brief Take the oldest method queued on this invoker.
+     */
+    bool pop_method( sc_process_b*& method_p );
+
+    /**
+     *  \brief Take the newest method queued on another invoker.
+     */
+    bool steal_method( sc_process_b*& method_p );
+
     SC_HAS_PROCESS(Invoker);
     Invoker(sc_module_name name);
+    ~Invoker();
 
     sc_thread_handle proc_handle;
-    std::list<sc_process_b*> method_queue;
-    int method_group_no;
+    unsigned int m_index;                       // in m_invokers
+    std::deque<sc_process_b*> method_queue;     // issued, not yet run
+    unsigned int m_queued;                      // size of method_queue
+    pthread_mutex_t m_queue_mutex;              // guards method_queue
+    std::vector<sc_process_b*> m_done_methods;  // run since the last wakeup
+    std::vector<sc_process_b*> m_waiting_methods; // of those, to wait queue
+
+    // utilization counters, printed by print_invoker_stats()
+    unsigned long long m_wakeups;
+    unsigned long long m_methods_run;
+    unsigned long long m_methods_stolen;
+    unsigned long long m_busy_cycles;
     
 };
 
 
-Invoker::Invoker(sc_module_name name) {
+Invoker::Invoker(sc_module_name name) 
+  : m_index(0), m_queued(0), m_wakeups(0), m_methods_run(0), 
+    m_methods_stolen(0), m_busy_cycles(0) {
      class sc_process_handle method_invoker_handle = sc_core::sc_get_curr_simcontext() ->  create_invoker_process ("invoker",false,(static_cast < sc_core::SC_ENTRY_FUNC  >  ((&Invoker::method_invoker))),(this),0,0 /*invoker_id*/);
       (this) -> sensitive << method_invoker_handle;
       (this) -> sensitive_pos << method_invoker_handle;
       (this) -> sensitive_neg << method_invoker_handle;
 
     proc_handle = method_invoker_handle;
+    pthread_mutex_init( &m_queue_mutex, NULL );
+
+}
+
+Invoker::~Invoker() {
+    pthread_mutex_destroy( &m_queue_mutex );
+}
 
+void Invoker::push_methods( std::vector<sc_process_b*>::const_iterator first,
+                            std::vector<sc_process_b*>::const_iterator last ) {
+    pthread_mutex_lock( &m_queue_mutex );
+    method_queue.insert( method_queue.end(), first, last );
+    __atomic_store_n( &m_queued, method_queue.size(), __ATOMIC_RELAXED );
+    pthread_mutex_unlock( &m_queue_mutex );
+}
+
+bool Invoker::pop_method( sc_process_b*& method_p ) {
+    if ( __atomic_load_n( &m_queued, __ATOMIC_RELAXED ) == 0 )
+        return false;
+    bool found = false;
+    pthread_mutex_lock( &m_queue_mutex );
+    if ( !method_queue.empty() ) {
+        method_p = method_queue.front();
+        method_queue.pop_front();
+        __atomic_store_n( &m_queued, method_queue.size(), __ATOMIC_RELAXED );
+        found = true;
+    }
+    pthread_mutex_unlock( &m_queue_mutex );
+    return found;
+}
+
+// All queued methods were issued together and checked against each other,
+// so any invoker may run any of them. The thief takes the newest one, away
+// from the owner, which takes the oldest.
+bool Invoker::steal_method( sc_process_b*& method_p ) {
+    std::vector<Invoker*>& invokers = simcontext()->m_invokers;
+    unsigned int n = invokers.size();
+    for ( unsigned int i = 1; i < n; i++ ) {
+        Invoker* victim_p = invokers[ ( m_index + i ) % n ];
+        if ( __atomic_load_n( &victim_p->m_queued, __ATOMIC_RELAXED ) == 0 )
+            continue;
+        bool found = false;
+        pthread_mutex_lock( &victim_p->m_queue_mutex );
+        if ( !victim_p->method_queue.empty() ) {
+            method_p = victim_p->method_queue.back();
+            victim_p->method_queue.pop_back();
+            __atomic_store_n( &victim_p->m_queued, 
+                              victim_p->method_queue.size(), __ATOMIC_RELAXED );
+            found = true;
+        }
+        pthread_mutex_unlock( &victim_p->m_queue_mutex );
+        if ( found ) {
+            m_methods_stolen++;
+            return true;
+        }
+    }
+    return false;
 }
 
 void Invoker::method_invoker() {
 	while(1) {
-		for(std::list<sc_process_b*>::iterator method_iter = method_queue.begin();
-			method_iter != method_queue.end(); method_iter++) {
-			sc_process_b* current_method = (*method_iter);
+		m_wakeups++;
+		cycles_t start_cycles = currentcycles();
+		sc_process_b* current_method;
+		// run the own methods first, then help the other invokers
+		while ( pop_method( current_method ) || steal_method( current_method ) ) {
       //added for getting the timestamp of the underlying method, ZC 2019,Dec,10
       proc_handle->set_timestamp(current_method->get_timestamp());
 
@@ -234,7 +340,9 @@ void Invoker::method_invoker() {
 			( (sc_process_b*) proc_handle)->cur_invoker_method_handle = current_method;
 			DCAST<sc_method_process*>(current_method)->clear_trigger();
 			current_mod->invoke_method(func_ptr);
+			m_done_methods.push_back(current_method);
 		}
+		m_busy_cycles += currentcycles() - start_cycles;
 		{
 			/*DM 07/24/2019 */	
 			
@@ -249,8 +357,10 @@ void Invoker::method_invoker() {
                 assert( sc_get_curr_simcontext()->is_locked_and_owner() );
 #endif
 
-			while( !method_queue.empty() ) {
-				sc_process_b* current_method = method_queue.front();
+			// commit the whole batch in this one critical section
+			for(std::vector<sc_process_b*>::iterator method_iter = m_done_methods.begin();
+				method_iter != m_done_methods.end(); method_iter++) {
+				current_method = *method_iter;
 				switch(current_method->m_trigger_type) {
 					case sc_process_b::STATIC:
 						current_method->m_sensitivity_events->add_dynamic(RCAST<sc_method_handle>( current_method ));
@@ -258,19 +368,19 @@ void Invoker::method_invoker() {
 						current_method->m_event_count = current_method->m_sensitivity_events->size();
 						current_method->m_trigger_type = sc_process_b::OR_LIST;
 						current_method->m_process_state=2;
-						sc_get_curr_simcontext()->add_to_wait_queue( current_method );
+						m_waiting_methods.push_back( current_method );
 						break;
 					case sc_process_b::EVENT:
 						current_method->m_process_state=2;
-						sc_get_curr_simcontext()->add_to_wait_queue( current_method );
+						m_waiting_methods.push_back( current_method );
 						break;
 					case sc_process_b::OR_LIST:
 						current_method->m_process_state=2;
-						sc_get_curr_simcontext()->add_to_wait_queue( current_method );
+						m_waiting_methods.push_back( current_method );
 						break;
 					case sc_process_b::AND_LIST:
 						current_method->m_process_state=2;
-						sc_get_curr_simcontext()->add_to_wait_queue( current_method );
+						m_waiting_methods.push_back( current_method );
 						break;
 					case sc_process_b::TIMEOUT:
 						current_method->m_process_state=3;
@@ -297,12 +407,15 @@ void Invoker::method_invoker() {
     				    }
 				}
 				sc_get_curr_simcontext()->new_waiting_proc.push_back(current_method);
-				sc_get_curr_simcontext()->running_methods--;
-				sc_get_curr_simcontext()->remove_running_process( current_method );
 				//method_group_no = current_method->group_no; //ASSUMES 1to1 METHOD-to-INVOKER MAPPING
 				//sc_get_curr_simcontext()->running_groups[method_group_no].erase(current_method);
-				method_queue.pop_front();
 			}
+			sc_get_curr_simcontext()->add_to_wait_queue( m_waiting_methods );
+			sc_get_curr_simcontext()->running_methods -= m_done_methods.size();
+			sc_get_curr_simcontext()->remove_running_processes( m_done_methods );
+			m_waiting_methods.clear();
+			m_methods_run += m_done_methods.size();
+			m_done_methods.clear();
 			suspend_invoker();
 		}
 	}
@@ -320,6 +433,7 @@ void Invoker::suspend_invoker() {
 	pthread_mutex_unlock( &sc_get_curr_simcontext()->kernel_request_mutex );
 	
 	if(cur_kernel_requests == 1 && /*simc_p->running_groups[method_group_no].empty()*/simc_p->running_invokers.size() == 0) {
+	simc_p->enable_handoff();
 	simc_p->oooschedule( proc_handle->m_cor_p );
 	}		
 
@@ -329,6 +443,9 @@ void Invoker::suspend_invoker() {
 		simc_p->suspend_cor( proc_handle->m_cor_p );
 		DEBUG_MSG( DEBUG_NAME , this, "resuming thread");
 	}
+	else {
+		simc_p->resume_handoff_cor();
+	}
 }
     
 /* the use of already_checked is for prediction of conflict.
@@ -422,7 +539,11 @@ sc_kernel_lock::sc_kernel_lock()
     if ( simc_p->is_locked_and_owner() ) 
         m_cor_p->increment_counter();
     else // acquire the kernel lock to protect the simulation kernel
+    {
         simc_p->acquire_sched_mutex();
+        // apply the notifications posted while the lock was free
+        simc_p->drain_notifications();
+    }
 }
 
 sc_kernel_lock::~sc_kernel_lock()
@@ -439,6 +560,15 @@ sc_kernel_lock::~sc_kernel_lock()
         simc_p->release_sched_mutex(); // release the kernel lock
 }
 
+// a scoped lock of the process heaps
+struct sc_process_heaps_lock {
+    CHNL_MTX_TYPE_& m_ref;
+    explicit sc_process_heaps_lock( CHNL_MTX_TYPE_& mtx ) : m_ref( mtx )
+        { CHNL_MTX_LOCK_( m_ref ); }
+    ~sc_process_heaps_lock()
+        { CHNL_MTX_UNLOCK_( m_ref ); }
+};
+
 
 // ----------------------------------------------------------------------------
 //  CLASS : sc_process_table
@@ -732,9 +862,29 @@ sc_simcontext::init()
 
     reset_curr_proc();
     m_next_proc_id = -1;
-    m_timed_events = new sc_ppq<sc_event_timed*>( 128, sc_notify_time_compare );
+    m_timed_events = sc_timed_event_queue::create();
     m_something_to_trace = false;
     m_runnable = new sc_runnable;
+    m_conflict_filter_p = new sc_ooo_conflict_filter;
+    m_notify_posts = 0;
+    m_affinity_p = new sc_affinity;
+    m_profile_p = sc_profile::file_name() ? new sc_profile : 0;
+    m_issue_log_p = sc_issue_log::create();
+    m_conflict_blocker_p = 0;
+    m_synch_heap_p = new sc_process_heap;
+    m_active_heap_p = new sc_process_heap;
+    m_time_heap_p = new sc_process_heap;
+    m_notify_heap_p = new sc_process_heap;
+    m_process_heaps_built = false;
+    m_process_heap_limit = 0;
+    m_wakeup_full_scan = true;
+    m_wakeup_heap_p = new sc_process_heap;
+    m_wakeup_heap_limit = 64;
+    m_wakeup_mark = 0;
+    m_notify_clean_time = sc_timestamp();
+    m_park_epoch = 1;
+    m_handoff_cor = 0;
+    m_handoff_enabled = false;
     m_collectable = new sc_process_list;
     m_time_params = new sc_time_params;
     //m_curr_time = SC_ZERO_TIME; // 08/19/2015 GL: to be removed
@@ -784,6 +934,11 @@ sc_simcontext::init()
 void
 sc_simcontext::clean()
 {
+    // notifications still posted are dropped with their processes
+    for ( sc_process_b* proc_p = m_notify_posts; proc_p;
+          proc_p = proc_p->m_notify_posts.m_next_p )
+        proc_p->m_notify_posts.m_pending = false;
+    m_notify_posts = 0;
     delete m_object_manager;
     delete m_module_registry;
     delete m_port_registry;
@@ -800,6 +955,15 @@ sc_simcontext::clean()
     }
     m_trace_files.resize(0);
     delete m_runnable;
+    delete m_conflict_filter_p;
+    delete m_affinity_p;
+    delete m_profile_p;
+    delete m_issue_log_p;
+    delete m_synch_heap_p;
+    delete m_active_heap_p;
+    delete m_time_heap_p;
+    delete m_notify_heap_p;
+    delete m_wakeup_heap_p;
     delete m_collectable;
     delete m_time_params;
     delete m_cor_pkg;
@@ -817,7 +981,10 @@ sc_simcontext::sc_simcontext() :
     m_process_table(0), m_curr_proc_queue(),
     m_write_check(false), m_next_proc_id(-1), m_child_events(),
     m_child_objects(), m_delta_events(), m_timed_events(0), m_trace_files(),
-    m_something_to_trace(false), m_runnable(0), m_collectable(0), 
+    m_something_to_trace(false), m_runnable(0), m_conflict_filter_p(0),
+    m_notify_posts(0), m_affinity_p(0), m_profile_p(0), m_issue_log_p(0),
+    m_conflict_blocker_p(0),
+    m_collectable(0), 
     m_time_params(), m_max_time(SC_ZERO_TIME), 
     //m_curr_time(SC_ZERO_TIME), // 08/19/2015 GL: to be removed
     m_change_stamp(0), m_forced_stop(false), m_paused(false),
@@ -828,7 +995,10 @@ sc_simcontext::sc_simcontext() :
     m_simulation_status(SC_ELABORATION), m_start_of_simulation_called(false),
     m_cor_pkg(0), m_cor(0), m_one_delta_cycle(false), m_one_timed_cycle(false),
     m_finish_time(SC_ZERO_TIME),
-    workload_table(0),visits(0),old_sys_time(0),m_synch_thread_queue(0),
+    workload_table(0),visits(0),old_sys_time(0),m_synch_heap_p(0),
+    m_active_heap_p(0), m_time_heap_p(0), m_notify_heap_p(0),
+    m_process_heaps_built(false),
+    m_process_heap_limit(0),
     m_starvation_policy(SC_RUN_TO_TIME),last_seg_id(-1),
     m_invokers(0), //DM 05/27/2019
     event_notification_update(false),
@@ -836,6 +1006,7 @@ sc_simcontext::sc_simcontext() :
     num_kernel_requests(0),
     total_runrdycheck(0),total_eventcheck(0),total_waitcheck(0),total_threadevent(0),total_delivery(0),total_eventpred(0)
 {
+    CHNL_MTX_INIT_( m_process_heaps_mutex );
     init();
     pthread_mutex_init( &kernel_request_mutex, NULL );
 }
@@ -843,6 +1014,7 @@ sc_simcontext::sc_simcontext() :
 sc_simcontext::~sc_simcontext()
 {
     clean();
+    CHNL_MTX_DESTROY_( m_process_heaps_mutex );
 }
 
 /* 
@@ -865,6 +1037,143 @@ void sc_simcontext::remove_from_wait_queue(sc_process_b* process_h)
     m_waiting_proc_queue.erase(process_h);
 }
 
+/* 
+    add a batch of processes to the wait queue
+*/
+void sc_simcontext::add_to_wait_queue(const std::vector<sc_process_b*>& procs)
+{
+    if ( procs.empty() )
+        return;
+    m_waiting_proc_queue.insert(procs.begin(), procs.end());
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::remove_running_processes"
+// | 
+// | This method removes a batch of processes from the running queue in a 
+// | single pass. The batch is sorted in place.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::remove_running_processes( std::vector<sc_process_b*>& procs )
+{
+    if ( procs.empty() )
+        return;
+    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+    {
+        for ( std::size_t i = 0; i < procs.size(); i++ )
+            profile_finished( procs[i] );
+    }
+    std::sort( procs.begin(), procs.end() );
+    std::list<sc_process_b*>::iterator it = m_curr_proc_queue.begin();
+    while ( it != m_curr_proc_queue.end() )
+    {
+        if ( std::binary_search( procs.begin(), procs.end(), *it ) )
+            it = m_curr_proc_queue.erase( it );
+        else
+            it++;
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::issue_method_wave"
+// | 
+// | This method hands the methods issued by oooschedule() to the idle 
+// | invokers. The wave is sorted by timestamp and cut into one contiguous 
+// | batch per invoker, preferably where the timestamp changes, so that 
+// | every invoker runs and commits a timestamp-homogeneous batch per 
+// | wakeup. Invokers that finish early steal from the others.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::issue_method_wave()
+{
+    if ( m_method_wave.empty() )
+        return;
+    std::stable_sort( m_method_wave.begin(), m_method_wave.end(),
+                      sc_ready_time_compare<sc_process_b*> );
+
+    std::vector<sc_process_b*>::const_iterator first = m_method_wave.begin();
+    std::vector<sc_process_b*>::const_iterator end = m_method_wave.end();
+    for ( unsigned int i = 0; i < m_idle_invokers.size() && first != end; 
+          i++ )
+    {
+        unsigned int invokers_left = m_idle_invokers.size() - i;
+        std::size_t target = 
+            ( ( end - first ) + invokers_left - 1 ) / invokers_left;
+        std::vector<sc_process_b*>::const_iterator last = first + target;
+        if ( invokers_left > 1 && last != end )
+        {
+            // end the batch early at a timestamp change in its second half
+            std::vector<sc_process_b*>::const_iterator cut = last;
+            while ( cut - first > (std::ptrdiff_t)( target + 1 ) / 2 &&
+                    !( (*( cut - 1 ))->get_timestamp() < 
+                       (*cut)->get_timestamp() ) )
+                cut--;
+            if ( cut - first > (std::ptrdiff_t)( target + 1 ) / 2 )
+                last = cut;
+        }
+        else
+        {
+            last = end;
+        }
+        m_idle_invokers[i]->push_methods( first, last );
+        ready_invokers.insert( m_idle_invokers[i] );
+        first = last;
+    }
+    m_method_wave.clear();
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::print_invoker_stats"
+// | 
+// | This method prints, for each invoker, how often it was woken up, how 
+// | many methods it ran (and how many of them it stole from other invokers) 
+// | and the share of the elapsed cycles it spent running methods.
+// +----------------------------------------------------------------------------
+void 
+sc_simcontext::print_invoker_stats( unsigned long long elapsed_cycles )
+{
+    for ( std::vector<Invoker*>::iterator invok_iter = m_invokers.begin();
+          invok_iter != m_invokers.end(); invok_iter++ )
+    {
+        Invoker* invoker_p = *invok_iter;
+        std::cout << "invoker " << invoker_p->m_index << ": "
+            << invoker_p->m_wakeups << " wakeups, "
+            << invoker_p->m_methods_run << " methods run, "
+            << invoker_p->m_methods_stolen << " stolen, "
+            << invoker_p->m_busy_cycles << " cycles busy";
+        if ( elapsed_cycles != 0 )
+            std::cout << " (" 
+                << 100 * invoker_p->m_busy_cycles / elapsed_cycles
+                << "% utilization)";
+        std::cout << std::endl;
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::profile_blocked"
+// | 
+// | This method charges a process that oooschedule() could not issue to the
+// | segment of the process its conflict check failed on, or to 
+// | SC_PROFILE_NO_INVOKER if it had no conflict but all invokers were busy.
+// +----------------------------------------------------------------------------
+void 
+sc_simcontext::profile_blocked( sc_process_b* process_h )
+{
+    int blocker_seg_id = m_conflict_blocker_p != 0 ?
+        m_conflict_blocker_p->get_segment_id() : SC_PROFILE_NO_INVOKER;
+    m_conflict_blocker_p = 0;
+    m_profile_p->blocked( process_h, blocker_seg_id, currentcycles() );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::profile_finished"
+// +----------------------------------------------------------------------------
+void 
+sc_simcontext::profile_finished( sc_process_b* process_h )
+{
+    m_profile_p->finished( process_h, currentcycles() );
+}
+
 // +----------------------------------------------------------------------------
 // |"sc_simcontext::active_object"
 // | 
@@ -1390,12 +1699,11 @@ void sc_simcontext::print_events_states()
             printf("event name        : %s\n" ,(*event_it)->name());
             printf("notification time : ");
             bool flag = false;
-            for(std::set<sc_timestamp>::iterator 
-                it = (*event_it)->m_notify_timestamp_set.begin();
-                it != (*event_it)->m_notify_timestamp_set.end();
-                ++ it)
+            for(std::size_t i = 0;
+                i < (*event_it)->m_notify_timestamp_set.size();
+                ++ i)
             {
-                std::string t = it->to_string();
+                std::string t = (*event_it)->m_notify_timestamp_set[i].to_string();
                 if(!flag)
                 {
                     flag = true;
@@ -1470,7 +1778,6 @@ sc_simcontext::update_dependency_set()
 	    if(it1_seg != -1 && it1_seg != -2) 
 	    {
 	    	int _OoO_Prediction_Event_Notification_Table_Size=sqrt(_OoO_Combined_Data_Conflict_Table_Size); 
-		int Ncolumns_Data_Conflict_Table =sqrt(_OoO_Combined_Data_Conflict_Table_Size); //this should be changed. 
 
 	    	sc_method_handle method_p2;
 		for ( method_p2 = m_process_table->method_q_head(); 
@@ -1497,7 +1804,7 @@ sc_simcontext::update_dependency_set()
 			int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    		int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    		int table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * Ncolumns_Data_Conflict_Table + CDCT_id];
+	    		int table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id);
 	    		if(table_entry > 0) {
 	    		method_p2->combined_data_conflict_threads.insert(curr_thread);
 	    		}
@@ -1516,7 +1823,6 @@ sc_simcontext::update_dependency_set()
 
 	//DM 08/13/2019
 	int _OoO_Prediction_Event_Notification_Table_Size=sqrt(_OoO_Combined_Data_Conflict_Table_Size); 
-	int Ncolumns_Data_Conflict_Table =sqrt(_OoO_Combined_Data_Conflict_Table_Size); //this should be changed. 
 
 	curr_thread->dependent_threads.clear();
 	curr_thread->dependent_methods.clear();
@@ -1570,11 +1876,11 @@ sc_simcontext::update_dependency_set()
 	    int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    int table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * Ncolumns_Data_Conflict_Table + CDCT_id];
+	    int table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id);
 	    if(table_entry > 0) {
 	    	thread_p2->combined_data_conflict_threads[thread_p2->get_segment_id()].insert(curr_thread);
 	    }
-	    int reverse_table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id * Ncolumns_Data_Conflict_Table + CDCT_id1];
+	    int reverse_table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id, CDCT_id1);
 	    if(reverse_table_entry > 0) {
 	    	curr_thread->combined_data_conflict_threads[curr_thread->get_segment_id()].insert(thread_p2);
 	    }
@@ -1604,7 +1910,7 @@ sc_simcontext::update_dependency_set()
 	    int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    int reverse_table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id * Ncolumns_Data_Conflict_Table + CDCT_id1];
+	    int reverse_table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id, CDCT_id1);
 	    if(reverse_table_entry > 0) {
 	    	curr_thread->combined_data_conflict_methods[curr_thread->get_segment_id()].insert(method_p2);
 	    }
@@ -1661,6 +1967,9 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
     // running process handle: NULL if it is the root thread
     sc_process_b* m_process_b = get_curr_proc();
 
+    // apply the notifications posted by running processes
+    drain_notifications();
+
     event_notification_update = false; //DM 06/23/2019 for notify() that happen while simulation isn't running
 
     // 07/03/2016 GL: only the last process in the running queue can perfrom
@@ -1725,73 +2034,38 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
     	sc_timestamp time_earliest_running_ready_threads(-1,-1);
 	if (  _SYSC_SYNC_PAR_SIM==true ){
 	//needed legacy code
-    	int initial_has_running_thread_flag; //DM 4/10/2018
-    	for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin();  
-    	    it != m_all_proc.end(); 
-    	    it++ )
+    	int initial_has_running_thread_flag = 0; //DM 4/10/2018
+    	// earliest running, ready, wait-for-time or synchronizing process
+    	if ( earliest_process_time( m_active_heap_p, &is_active_process,
+    	                            time_earliest_running_ready_threads ) )
     	{
-    	    //running and ready
-    	    if((*it)->m_process_state==0 
-    	        || (*it)->m_process_state==1
-    	        || (*it)->m_process_state==3
-    	        || (*it)->m_process_state==32) //32 is for synchronous mode
-    	    {
-    	        initial_has_running_thread_flag = 1; //DM's variable
-    	        time_earliest_running_ready_threads
-    	            = (*it)->get_timestamp() < time_earliest_running_ready_threads
-    	            ? (*it)->get_timestamp() : time_earliest_running_ready_threads;
-    	    }
+    	    initial_has_running_thread_flag = 1; //DM's variable
     	}
 
-
-		sc_timestamp oldest_synch_thread_time;
-	
-		int has_synch_thread_flag=0;
-		
-		for ( std::list<sc_process_b*>::iterator it = m_synch_thread_queue.begin(); 
-				it != m_synch_thread_queue.end(); it++ )
-		{
-			if(has_synch_thread_flag==0){
-				has_synch_thread_flag=1;
-				oldest_synch_thread_time=(*it)->get_timestamp();
-			}
-			else
-			{
-				if((*it)->get_timestamp()<oldest_synch_thread_time){
-					oldest_synch_thread_time=(*it)->get_timestamp();
-				}
-			}
-		}
-
-		//push ALL earliest synch threads to ready queue
-		if(has_synch_thread_flag==1 && 
+		//push ALL earliest synch threads to ready queue, in the order
+		//they started to synchronize
+		if(!m_synch_heap_p->empty() && 
             m_runnable->is_empty() && 
             m_curr_proc_queue.size()==0)
         {
-            for ( std::list<sc_process_b*>::iterator 
-                it = m_synch_thread_queue.begin(); 
-                it != m_synch_thread_queue.end();
-                )
+            sc_timestamp oldest_synch_thread_time = m_synch_heap_p->top().ts;
+            while ( !m_synch_heap_p->empty() &&
+                    m_synch_heap_p->top().ts == oldest_synch_thread_time )
             {
-                if((*it)->get_timestamp() == oldest_synch_thread_time){
-                    if(dynamic_cast<sc_thread_process*>(*it) != NULL) { //DM 05/27/2019 support both methods and threads
-                        push_runnable_thread( dynamic_cast<sc_thread_process*>(*it) );
-                    }
-                    else {
-                        push_runnable_method( dynamic_cast<sc_method_process*>(*it) );
-                    }
-                    it=m_synch_thread_queue.erase(it);
+                sc_process_b* synch_h = m_synch_heap_p->top().proc_p;
+                m_synch_heap_p->pop();
+                if(dynamic_cast<sc_thread_process*>(synch_h) != NULL) { //DM 05/27/2019 support both methods and threads
+                    push_runnable_thread( dynamic_cast<sc_thread_process*>(synch_h) );
                 }
-                else
-                {
-                    it++;
+                else {
+                    push_runnable_method( dynamic_cast<sc_method_process*>(synch_h) );
                 }
             }
         }
         
         //DM 4/10/2018 final trace_cycle call for synchPDES, already in synchPDES region
         if(m_runnable->is_empty() && 
-            m_synch_thread_queue.size()==0 &&
+            m_synch_heap_p->empty() &&
             initial_has_running_thread_flag==0) 
         {
             if(time_earliest_running_ready_threads.get_infinite())
@@ -1826,10 +2100,24 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
         // 08/17/2015 GL: containers that keep processes with conflicts
         std::list<sc_method_handle> conflict_methods;
         std::list<sc_thread_handle> conflict_threads;
+
+        // a replay held back a ready process that is not next in the log
+        bool replay_held = false;
+
+        // any invoker that is not running can take any method
+        std::vector<Invoker*>& idle_invokers = m_idle_invokers;
+        idle_invokers.clear();
+        m_method_wave.clear();
+        for ( std::vector<Invoker*>::iterator invok_iter = m_invokers.begin();
+              invok_iter != m_invokers.end(); invok_iter++ )
+        {
+            if ( running_invokers.count( *invok_iter ) == 0 )
+                idle_invokers.push_back( *invok_iter );
+        }
     
         while ( (!m_runnable->is_empty()
                     && m_curr_proc_queue.size() - running_methods + running_invokers.size() <_SYSC_NUM_INVOKERS )
-		    || (!m_runnable->is_empty() && ready_invokers.size() != 0) )
+		    || (!m_runnable->is_empty() && !m_method_wave.empty()) )
         {
             // execute method processes
             m_runnable->toggle_methods();
@@ -1841,31 +2129,44 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
 
             if ( method_h != 0 ) 
             {
-		bool no_conflict = has_no_conflicts_method( (sc_process_b*)method_h, conflict_methods, conflict_threads );
+		bool no_conflict;
+		if ( SC_UNLIKELY_( m_issue_log_p != 0 ) &&
+		     !m_issue_log_p->may_issue( (sc_process_b*)method_h ) )
+		{
+		    no_conflict = false;
+		    replay_held = true;
+		}
+		else
+		    no_conflict = has_no_conflicts_method( (sc_process_b*)method_h, conflict_methods, conflict_threads );
                 // has no conflicts
                 if ( no_conflict /*has_no_conflicts_method( (sc_process_b*)method_h, conflict_methods, conflict_threads )*/ )
                 {
                 		m_curr_proc_queue.push_back( (sc_process_b*)method_h );
-        			if( running_invokers.count(method_to_invoker_map[ (sc_process_b*)method_h ]) == 0 ) 
+        			if( !idle_invokers.empty() ) 
                     		{
+					// handed to the invokers as one wave below
+					if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+					    m_profile_p->issued( (sc_process_b*)method_h, currentcycles() );
+					if ( SC_UNLIKELY_( m_issue_log_p != 0 ) )
+					    m_issue_log_p->issued( (sc_process_b*)method_h );
 					running_methods++;		
 					method_h->m_process_state=0;
-        				method_to_invoker_map[ (sc_process_b*)method_h ]->method_queue.push_back((sc_process_b*)method_h);
+        				m_method_wave.push_back((sc_process_b*)method_h);
 					//running_groups[method_h->group_no].insert(method_h);
-        				if ( ready_invokers.count(method_to_invoker_map[ (sc_process_b*)method_h ]) == 0 ) 
-                        		{
-        					ready_invokers.insert(method_to_invoker_map[ (sc_process_b*)method_h ]);
-        				}
         			}
         			else 
                     		{
         				conflict_methods.push_back( method_h );//DM 05/20/2019 for now, consider as a method with conflicts
         				m_curr_proc_queue.pop_back();
+					if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+					    m_profile_p->blocked( (sc_process_b*)method_h, SC_PROFILE_NO_INVOKER, currentcycles() );
         			}
                 }
                 else
                 {
                     conflict_methods.push_back( method_h );
+                    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+                        profile_blocked( (sc_process_b*)method_h );
                 }
                 //continue; DM 07/24/2019
             }
@@ -1906,7 +2207,15 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
                     std::cout << "checking conflicts for " << thread_h->name() << "\n" << std::endl;
                 }
 
-		bool no_conflict = has_no_conflicts( (sc_process_b*)thread_h, conflict_methods, conflict_threads );
+		bool no_conflict;
+		if ( SC_UNLIKELY_( m_issue_log_p != 0 ) &&
+		     !m_issue_log_p->may_issue( (sc_process_b*)thread_h ) )
+		{
+		    no_conflict = false;
+		    replay_held = true;
+		}
+		else
+		    no_conflict = has_no_conflicts( (sc_process_b*)thread_h, conflict_methods, conflict_threads );
         
                 if ( no_conflict /*has_no_conflicts( (sc_process_b*)thread_h, conflict_methods, conflict_threads)*/) 
                 {
@@ -1922,13 +2231,17 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
                     //end
                     m_curr_proc_queue.push_back( (sc_process_b*)thread_h );
                     thread_h->m_process_state=0;
+                    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+                        m_profile_p->issued( (sc_process_b*)thread_h, currentcycles() );
+                    if ( SC_UNLIKELY_( m_issue_log_p != 0 ) )
+                        m_issue_log_p->issued( (sc_process_b*)thread_h );
                     // do not switch to myself!
                     if ( m_process_b != (sc_process_b*)thread_h )
                     {
                         thread_h->m_process_state=0; //10:44 2017/3/10 ZC
                         if(verbosity_flag_4) 
                             std::cout << thread_h->name() << " is issued to run\n" << std::endl;
-                        m_cor_pkg->go( thread_h->m_cor_p );
+                        resume_issued_cor( thread_h->m_cor_p );
                     }
                 }
                 else
@@ -1936,17 +2249,21 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
                     if(verbosity_flag_4) 
                         std::cout << thread_h->name() << " cannot run and put back to ready queue\n" << std::endl;
                     conflict_threads.push_back( thread_h );
+                    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+                        profile_blocked( (sc_process_b*)thread_h );
                 }
             }
         }
 
+        issue_method_wave();
+
         //DM 05/16/2019
         for(std::unordered_set<Invoker*>::iterator invok_iter = ready_invokers.begin();
             invok_iter != ready_invokers.end(); /*invok_iter++*/) {
             running_invokers.insert(*invok_iter);
             if ( m_process_b != (sc_process_b*) (*invok_iter)->proc_handle ){
                             //thread_h->m_process_state=0; //10:44 2017/3/10 ZC
-                                    m_cor_pkg->go( ((*invok_iter)->proc_handle)->m_cor_p );
+                                    resume_issued_cor( ((*invok_iter)->proc_handle)->m_cor_p );
                 }
             invok_iter = ready_invokers.erase(invok_iter); // (bugfix 2/25/20, RD)
         }
@@ -1956,6 +2273,9 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
 
         // 08/17/2015 GL: move all the methods with conflicts back to the ready
         //                queue
+        // oldest first, as they are the first to become conflict free
+        conflict_methods.sort( sc_ready_time_compare<sc_method_handle> );
+        conflict_threads.sort( sc_ready_time_compare<sc_thread_handle> );
         while ( !conflict_methods.empty() )
         {
             push_runnable_method_front( conflict_methods.back() );
@@ -1970,9 +2290,17 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
             conflict_threads.pop_back();
         } 
 
+        // nothing will run to make the next process of the log ready
+        if ( replay_held && m_curr_proc_queue.size() == 0 )
+            m_issue_log_p->stalled();
+
         if ( cor_p == m_cor && m_curr_proc_queue.size() != 0) //DM 9/25/2018
         {
+            if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+                m_profile_p->kernel_lock_released( currentcycles() );
             m_cor_pkg->wait( cor_p ); // suspend the root thread
+            if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+                m_profile_p->kernel_lock_acquired( false, 0, currentcycles() );
         }
  
         
@@ -2006,6 +2334,7 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
             << total_delivery << " cycles" << std::endl;
 	std::cout << "event prediction runs for total of "
 	    << total_eventpred << " cycles" << std::endl;
+	print_invoker_stats( ooo_curr_cycles );
 	// std::cout << "oooschedule accounts for " 
         //     << ((double)(ooo_total_cycles - ooo_curr_cycles))/ooo_curr_cycles*100 
         //     << "% of total run-time" << std::endl;
@@ -2018,7 +2347,7 @@ sc_simcontext::oooschedule( sc_cor* cor_p )
 
     //when no running or ready thread, resume the sc_main
     if ( cor_p != m_cor ) {
-        m_cor_pkg->go( m_cor ); // resume the root thread
+        resume_issued_cor( m_cor ); // resume the root thread
     } 
     else { //DM 9/25/2018
         m_simulation_status = SC_PAUSED; 
@@ -2102,7 +2431,7 @@ void sc_simcontext::predict_wakeup_create_defining_tree(std::unordered_map<sc_pr
 		new_waiting_proc.push_back(*def_it);
 	}
 	
-	proc_it->possible_wakeup_time = sc_timestamp(-1,-1);
+	set_possible_wakeup_time( proc_it, sc_timestamp(-1,-1) );
 	proc_it->min_PWT_distance = sc_timestamp(-1,-1);
 	if(proc_it->PWT_defining_proc != NULL) {
 		proc_it->PWT_defining_proc->proc_defined.erase(proc_it);
@@ -2155,7 +2484,7 @@ void sc_simcontext::predict_wakeup_time_by_running_ready_threads()
                 		if(pred_it1_t < (*tree_iter)->possible_wakeup_time)
 				{
 					(*tree_iter)->min_PWT_distance = sc_timestamp(pred_t/res,pred_d);
-                    			(*tree_iter)->possible_wakeup_time = pred_it1_t;
+                    			set_possible_wakeup_time( *tree_iter, pred_it1_t );
 					if( (*tree_iter)->PWT_defining_proc != NULL) {
 						(*tree_iter)->PWT_defining_proc->proc_defined.erase(*tree_iter);
 					}
@@ -2201,7 +2530,7 @@ void sc_simcontext::predict_wakeup_time_by_running_ready_threads()
                 		if(pred_it1_t < (*tree_iter)->possible_wakeup_time)
 				{
                     			(*tree_iter)->min_PWT_distance = sc_timestamp(pred_t/res,pred_d);
-					(*tree_iter)->possible_wakeup_time = pred_it1_t;
+					set_possible_wakeup_time( *tree_iter, pred_it1_t );
 					if( (*tree_iter)->PWT_defining_proc != NULL) {
 						(*tree_iter)->PWT_defining_proc->proc_defined.erase(*tree_iter);
 					}
@@ -2251,7 +2580,7 @@ void sc_simcontext::predict_wakeup_time_by_running_ready_threads()
                 		if(pred_it1_t < (*tree_iter)->possible_wakeup_time)
 				{
 					(*tree_iter)->min_PWT_distance = sc_timestamp(pred_t/res,pred_d);
-                    			(*tree_iter)->possible_wakeup_time = pred_it1_t;
+                    			set_possible_wakeup_time( *tree_iter, pred_it1_t );
 					if( (*tree_iter)->PWT_defining_proc != NULL) {
 						(*tree_iter)->PWT_defining_proc->proc_defined.erase(*tree_iter);
 					}
@@ -2296,7 +2625,7 @@ void sc_simcontext::predict_wakeup_time_by_running_ready_threads()
                 		if(pred_it1_t < (*tree_iter)->possible_wakeup_time)
 				{
 					(*tree_iter)->min_PWT_distance = sc_timestamp(pred_t/res,pred_d);
-                    			(*tree_iter)->possible_wakeup_time = pred_it1_t;
+                    			set_possible_wakeup_time( *tree_iter, pred_it1_t );
 					if( (*tree_iter)->PWT_defining_proc != NULL) {
 						(*tree_iter)->PWT_defining_proc->proc_defined.erase(*tree_iter);
 					}
@@ -2323,6 +2652,54 @@ void sc_simcontext::predict_wakeup_time_by_running_ready_threads()
 
 }
 
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::predict_wakeup_time_by_event"
+// | 
+// | This method lowers the possible wake-up time of process p, which waits
+// | dynamically on event e, to the earliest notification of e after the 
+// | local time of p, and records e in wkup_t_evnt if it defines that time.
+// +----------------------------------------------------------------------------
+void sc_simcontext::predict_wakeup_time_by_event( sc_event* e, sc_process_b* p,
+        std::unordered_map<sc_process_b*,
+        std::unordered_map<sc_event*, sc_timestamp> >& wkup_t_evnt)
+{
+    sc_timestamp it1_t = p->get_timestamp();
+    sc_timestamp event_t = e->get_earliest_time_after_certain_time(it1_t);
+    //TODO, we may need to consider list wait here
+    //TODO done
+    if(event_t + sc_timestamp(0,1) < p->possible_wakeup_time) {
+        set_possible_wakeup_time( p, event_t + sc_timestamp(0,1) );
+        if( p->PWT_defining_proc != NULL) {
+            p->PWT_defining_proc->proc_defined.erase(p);
+        }
+        p->PWT_defining_proc = NULL;
+        mod_wakeup_proc.insert(p);
+        wkup_t_evnt.erase(p);
+        wkup_t_evnt[p][e] = event_t;
+    }
+    else if(event_t + sc_timestamp(0,1) == p->possible_wakeup_time) {
+        if( p->PWT_defining_proc != NULL) {
+            p->PWT_defining_proc->proc_defined.erase(p);
+        }
+        p->PWT_defining_proc = NULL;
+        wkup_t_evnt[p][e] = event_t;
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::predict_wakeup_time_by_events"
+// | 
+// | This method applies the pending event notifications to the possible 
+// | wake-up times of the waiting processes.
+// |
+// | Only the pairs of a waiting process and an event that changed since the
+// | last call are evaluated: the waiters of every event whose notification
+// | set changed, and the processes whose wake-up time was reset in this call
+// | (the defining tree). For any other pair, the earliest notification and
+// | the local time of the process are unchanged, and the possible wake-up 
+// | time has not risen since it was last evaluated, so it neither lowers the
+// | time nor allows a delivery. The first call evaluates all pairs.
+// +----------------------------------------------------------------------------
 void sc_simcontext::predict_wakeup_time_by_events(std::unordered_map<sc_process_b*,
         std::unordered_map<sc_event*, sc_timestamp> >& wkup_t_evnt)
 {
@@ -2331,72 +2708,82 @@ void sc_simcontext::predict_wakeup_time_by_events(std::unordered_map<sc_process_
         event_it != m_delta_events.end();
         ++ event_it)
     {   
+        sc_event* e = *event_it;
+        if(!m_wakeup_full_scan && e->m_wakeup_version == e->m_notify_set_version)
+            continue;
+        e->m_wakeup_version = e->m_notify_set_version;
+
         //iterate over all the registerred waiting threads on this event
         for(std::vector<sc_thread_handle>::iterator 
-            it1  = (*event_it)->m_threads_dynamic.begin();
-            it1 != (*event_it)->m_threads_dynamic.end();
+            it1  = e->m_threads_dynamic.begin();
+            it1 != e->m_threads_dynamic.end();
             ++ it1)
         {
-            sc_timestamp it1_t = (*it1)->get_timestamp();
-            sc_timestamp event_t = (*event_it)->get_earliest_time_after_certain_time(it1_t);
-            //TODO, we may need to consider list wait here
-            //TODO done
-            //wkup_t_evnt[(sc_process_b*)(*it1)][*event_it] = event_t;
-	    if(event_t + sc_timestamp(0,1) < (*it1)->possible_wakeup_time) {
-                    (*it1)->possible_wakeup_time = event_t + sc_timestamp(0,1);
-		    if( (*it1)->PWT_defining_proc != NULL) {
-		    	(*it1)->PWT_defining_proc->proc_defined.erase(*it1);
-		    }
-		    (*it1)->PWT_defining_proc = NULL;
-		    mod_wakeup_proc.insert(*it1);
-		    wkup_t_evnt.erase((sc_process_b*)(*it1));
-		    wkup_t_evnt[(sc_process_b*)(*it1)][*event_it] = event_t;
-		    //defining_tree.erase(*it1);
-	    }
-	    else if(event_t + sc_timestamp(0,1) == (*it1)->possible_wakeup_time) {
-	    	    (*it1)->possible_wakeup_time = event_t + sc_timestamp(0,1);
-		    if( (*it1)->PWT_defining_proc != NULL) {
-		    	(*it1)->PWT_defining_proc->proc_defined.erase(*it1);
-		    }
-		    (*it1)->PWT_defining_proc = NULL;
-		    //mod_wakeup_proc.insert(*it1);
-		    wkup_t_evnt[(sc_process_b*)(*it1)][*event_it] = event_t;
-		    //defining_tree.erase(*it1);
-	    }
+            predict_wakeup_time_by_event(e, *it1, wkup_t_evnt);
         }
         for(std::vector<sc_method_handle>::iterator 
-            it1  = (*event_it)->m_methods_dynamic.begin();
-            it1 != (*event_it)->m_methods_dynamic.end();
+            it1  = e->m_methods_dynamic.begin();
+            it1 != e->m_methods_dynamic.end();
             ++ it1)
         {
-            sc_timestamp it1_t = (*it1)->get_timestamp();
-            sc_timestamp event_t = (*event_it)->get_earliest_time_after_certain_time(it1_t);
-            //TODO, we may need to consider list wait here
-            //TODO done
-            //wkup_t_evnt[(sc_process_b*)(*it1)][*event_it] = event_t;
-	    if(event_t + sc_timestamp(0,1) < (*it1)->possible_wakeup_time) {
-                    (*it1)->possible_wakeup_time = event_t + sc_timestamp(0,1);
-		    if( (*it1)->PWT_defining_proc != NULL) {
-		    	(*it1)->PWT_defining_proc->proc_defined.erase(*it1);
-		    }
-		    (*it1)->PWT_defining_proc = NULL;
-		    mod_wakeup_proc.insert(*it1);
-		    wkup_t_evnt.erase((sc_process_b*)(*it1));
-		    wkup_t_evnt[(sc_process_b*)(*it1)][*event_it] = event_t;
-		    //defining_tree.erase(*it1);
-	    }
-	    else if(event_t + sc_timestamp(0,1) == (*it1)->possible_wakeup_time) {
-	    	    (*it1)->possible_wakeup_time = event_t + sc_timestamp(0,1);
-		    if( (*it1)->PWT_defining_proc != NULL) {
-		    	(*it1)->PWT_defining_proc->proc_defined.erase(*it1);
-		    }
-		    (*it1)->PWT_defining_proc = NULL;
-		    //mod_wakeup_proc.insert(*it1);
-		    wkup_t_evnt[(sc_process_b*)(*it1)][*event_it] = event_t;
-		    //defining_tree.erase(*it1);
-	    }
-	}
+            predict_wakeup_time_by_event(e, *it1, wkup_t_evnt);
+        }
+    }
+    if(m_wakeup_full_scan) {
+        m_wakeup_full_scan = false;
+        return;
+    }
 
+    //the processes reset in this call, on the events they may wait on
+    std::vector<sc_event*> wait_events;
+    for(std::unordered_set<sc_process_b*>::iterator 
+        tree_it  = defining_tree.begin();
+        tree_it != defining_tree.end();
+        ++ tree_it)
+    {
+        sc_process_b* p = *tree_it;
+        wait_events.clear();
+        if(p->m_event_p != NULL) 
+            wait_events.push_back(const_cast<sc_event*>(p->m_event_p));
+        if(p->m_event_list_p != NULL)
+            for(int i = 0; i < p->m_event_list_p->size(); i++)
+                wait_events.push_back(const_cast<sc_event*>(
+                    p->m_event_list_p->m_events[i]));
+        if(p->m_timeout_event_p != NULL)
+            wait_events.push_back(p->m_timeout_event_p);
+        if(p->m_sensitivity_events != NULL)
+            for(int i = 0; i < p->m_sensitivity_events->size(); i++)
+                wait_events.push_back(const_cast<sc_event*>(
+                    p->m_sensitivity_events->m_events[i]));
+        std::sort(wait_events.begin(), wait_events.end());
+        wait_events.erase(std::unique(wait_events.begin(), wait_events.end()),
+                          wait_events.end());
+
+        for(std::vector<sc_event*>::iterator 
+            event_it  = wait_events.begin();
+            event_it != wait_events.end();
+            ++ event_it)
+        {
+            sc_event* e = *event_it;
+            int index = e->m_delta_event_index;
+            if(index < 0 || index >= (int)m_delta_events.size() 
+               || m_delta_events[index] != e)
+                continue;
+            //the pointers above may be left over from an earlier wait
+            bool waits_on_e;
+            if(p->m_process_kind == SC_METHOD_PROC_)
+                waits_on_e = std::find(e->m_methods_dynamic.begin(),
+                                 e->m_methods_dynamic.end(),
+                                 RCAST<sc_method_handle>(p))
+                             != e->m_methods_dynamic.end();
+            else
+                waits_on_e = std::find(e->m_threads_dynamic.begin(),
+                                 e->m_threads_dynamic.end(),
+                                 RCAST<sc_thread_handle>(p))
+                             != e->m_threads_dynamic.end();
+            if(waits_on_e)
+                predict_wakeup_time_by_event(e, p, wkup_t_evnt);
+        }
     }
 }
 
@@ -2858,66 +3245,29 @@ void sc_simcontext::clean_up_old_event_notifications()
     //however, the earliest running/ready thread is at (2,0)
     //so it will not take effect any more and should be removed
     //to save space
+    //
+    //a thread waiting for an and-list of events also counts:
+    //a thread is waiting for e1&e2, and th is at time 1
+    //e1 is already notified at 2
+    //e2 is not notified yet.
+    //if we dont consider th, then e1 at 2 is removed
+    //which is wrong
     sc_timestamp time_earliest_all_threads(-1,-1);
-    for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin();  
-        it != m_all_proc.end(); 
-        it++ )
-    {
-        //running and ready and wait-for-time and wait-for-and-list-events
-        if((*it)->m_process_state==0 
-            || (*it)->m_process_state==1
-            || (*it)->m_process_state==3
-            || (*it)->m_process_state==2    
-            || (*it)->m_process_state==32)  
-        {
-            if((*it)->m_process_state!=2)
-                time_earliest_all_threads
-                    = (*it)->get_timestamp() < time_earliest_all_threads
-                    ? (*it)->get_timestamp() : time_earliest_all_threads;
-            else    
-            {
-                //we need to also consider and events
-                //for example, a thread is waiting for e1&e2, and
-                //th is at time 1
-                //e1 is already notified at 2
-                //e2 is not notified yet.
-                //
-                //if we dont consider th, then e1 at 2 is removed
-                //which is wrong
-                if((*it)->m_event_list_p!=NULL && 
-                    (*it)->m_event_list_p->and_list())
-                {
-                    time_earliest_all_threads
-                    = (*it)->get_timestamp() < time_earliest_all_threads
-                    ? (*it)->get_timestamp() : time_earliest_all_threads;
-                }
-            }
-        }
-    }
+    earliest_process_time( m_notify_heap_p, &holds_notifications,
+                           time_earliest_all_threads );
+
+    //nothing new to remove unless the earliest time advanced
+    if ( !( m_notify_clean_time < time_earliest_all_threads ) )
+        return;
+    m_notify_clean_time = time_earliest_all_threads;
 
     std::vector<sc_event*> events_to_be_removed;
     for(std::vector<sc_event*>::iterator event_it=m_delta_events.begin();
         event_it!=m_delta_events.end();
         event_it++)
     {
-        std::vector<sc_timestamp> times_to_be_removed;
-        for(std::set<sc_timestamp>::iterator 
-            it = (*event_it)->m_notify_timestamp_set.begin();
-            it != (*event_it)->m_notify_timestamp_set.end();
-            ++it)
-        {
-            if((*it) < time_earliest_all_threads) {
-                times_to_be_removed.push_back(*it);
-            }
-        }
-        for(std::vector<sc_timestamp>::iterator 
-            it2 = times_to_be_removed.begin();
-            it2 != times_to_be_removed.end();
-            ++it2)
-        {
-            (*event_it) -> erase_notification_time(*it2);
-        }
-        if((*event_it)->m_notify_timestamp_set.empty())
+        if((*event_it)->erase_notification_times_before(
+                time_earliest_all_threads))
                 events_to_be_removed.push_back((*event_it));
     }
 
@@ -2945,8 +3295,8 @@ void sc_simcontext::clean_up_old_event_notifications()
 // +----------------------------------------------------------------------------
 bool
 sc_simcontext::has_no_conflicts( sc_process_b* process_h,
-        std::list<sc_method_handle> conflict_methods,
-        std::list<sc_thread_handle> conflict_threads )
+        const std::list<sc_method_handle>& conflict_methods,
+        const std::list<sc_thread_handle>& conflict_threads )
 {
     // assume we have acquired the kernel lock upon here
 #ifdef SC_LOCK_CHECK
@@ -2962,6 +3312,19 @@ sc_simcontext::has_no_conflicts( sc_process_b* process_h,
     sc_thread_process* m_handle = (sc_thread_process*) process_h;
     std::list<sc_process_b*> concurrent_processes;
 if(prediction_switch) {
+    // nothing active may conflict with this segment, whatever the
+    // timestamps are
+    if ( !may_conflict_with_active( process_h ) )
+        return true;
+
+    // the process it conflicted with last time has not moved
+    if ( is_parked( process_h ) )
+    {
+        m_conflict_blocker_p = process_h->m_blocker_p;
+        return false;
+    }
+    process_h->m_blocker_p = 0;
+
     for(std::unordered_set<sc_method_process*>::iterator method_it = 
 	m_handle->combined_data_conflict_methods[m_handle->get_segment_id()].begin();
 	method_it != m_handle->combined_data_conflict_methods[m_handle->get_segment_id()].end();
@@ -3004,7 +3367,7 @@ else
     // concurrent processes in the RUN and READY queues with an earlier time
     // 12/21/2016 GL: or the same timestamp
 
-	for ( std::list<sc_method_handle>::iterator it = conflict_methods.begin();
+	for ( std::list<sc_method_handle>::const_iterator it = conflict_methods.begin();
           it != conflict_methods.end(); it++ )
     {
         if ( (*it)->get_timestamp() < ts ) {
@@ -3013,7 +3376,7 @@ else
         } 
     }
 
-    for ( std::list<sc_thread_handle>::iterator it = conflict_threads.begin();
+    for ( std::list<sc_thread_handle>::const_iterator it = conflict_threads.begin();
           it != conflict_threads.end(); it++ )
     {
         if ( (*it)->get_timestamp() < ts ) {
@@ -3089,14 +3452,7 @@ else
     //ZC, 2019
     if (prediction_switch)
     {
-        for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin();  it != m_all_proc.end(); it++ )
-        {
-            sc_timestamp ts_tmp=(*it)->possible_wakeup_time;
-            if ( ts_tmp < ts && (*it)->m_process_state == 2) {
-                concurrent_processes.push_back( (*it) );
-            }
-            
-        }
+        push_waiting_before( ts, concurrent_processes );
     }
 }
     // 06/16/2016 GL: if synchronized parallel simulation is enabled,
@@ -3119,11 +3475,14 @@ else
 		if (prediction_switch){
 
 			if ( conflict_between_with_prediction( process_h, concur_process_h ) ){
+				park( process_h, concur_process_h );
+				m_conflict_blocker_p = concur_process_h;
 				return false;
 			}
 		}
 		else{
 			if ( conflict_between( process_h, concur_process_h ) ){
+				m_conflict_blocker_p = concur_process_h;
 				return false;
 			}
 		}
@@ -3133,8 +3492,8 @@ else
 
 bool
 sc_simcontext::has_no_conflicts_method( sc_process_b* process_h,
-		std::list<sc_method_handle> conflict_methods,
-		std::list<sc_thread_handle> conflict_threads )
+		const std::list<sc_method_handle>& conflict_methods,
+		const std::list<sc_thread_handle>& conflict_threads )
 {
     // assume we have acquired the kernel lock upon here
 #ifdef SC_LOCK_CHECK
@@ -3150,6 +3509,19 @@ sc_simcontext::has_no_conflicts_method( sc_process_b* process_h,
     sc_method_process* m_handle = (sc_method_process*) process_h;
     std::list<sc_process_b*> concurrent_processes;
 if(prediction_switch) {
+    // nothing active may conflict with this segment, whatever the
+    // timestamps are
+    if ( !may_conflict_with_active( process_h ) )
+        return true;
+
+    // the process it conflicted with last time has not moved
+    if ( is_parked( process_h ) )
+    {
+        m_conflict_blocker_p = process_h->m_blocker_p;
+        return false;
+    }
+    process_h->m_blocker_p = 0;
+
     for(std::unordered_set<sc_method_process*>::iterator method_it = 
 	m_handle->combined_data_conflict_methods.begin();
 	method_it != m_handle->combined_data_conflict_methods.end();
@@ -3185,7 +3557,7 @@ else {
     
     // concurrent processes in the RUN and READY queues with an earlier time
     // 12/21/2016 GL: or the same timestamp
-	for ( std::list<sc_method_handle>::iterator it = conflict_methods.begin();
+	for ( std::list<sc_method_handle>::const_iterator it = conflict_methods.begin();
           it != conflict_methods.end(); it++ )
     {
         if ( (*it)->get_timestamp() < ts ) {
@@ -3194,7 +3566,7 @@ else {
         } 
     }
 
-	for ( std::list<sc_thread_handle>::iterator it = conflict_threads.begin();
+	for ( std::list<sc_thread_handle>::const_iterator it = conflict_threads.begin();
           it != conflict_threads.end(); it++ )
     {
         if ( (*it)->get_timestamp() < ts ) {
@@ -3270,14 +3642,7 @@ else {
     //ZC, 2019
     if (prediction_switch)
     {
-        for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin();  it != m_all_proc.end(); it++ )
-        {
-            sc_timestamp ts_tmp=(*it)->possible_wakeup_time;
-            if ( ts_tmp < ts && (*it)->m_process_state == 2) {
-                concurrent_processes.push_back( (*it) );
-            }
-            
-        }
+        push_waiting_before( ts, concurrent_processes );
     }
 }
     // 06/16/2016 GL: if synchronized parallel simulation is enabled,
@@ -3300,11 +3665,14 @@ else {
         if (prediction_switch){
 
             if ( conflict_between_with_prediction( process_h, concur_process_h ) ){
+                park( process_h, concur_process_h );
+                m_conflict_blocker_p = concur_process_h;
                 return false;
             }
         }
         else{
             if ( conflict_between( process_h, concur_process_h ) ){
+                m_conflict_blocker_p = concur_process_h;
                 return false;
             }
         }
@@ -3313,6 +3681,203 @@ else {
 }
 
 
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::park"
+// | 
+// | With prediction, whether a ready process conflicts with another process
+// | depends only on the segments, instances and states of the two, the 
+// | timestamp of the ready process, and the timestamp (or the wake-up time,
+// | if waiting) of the other one. After a failed check, the ready process 
+// | is parked on the process it conflicts with, together with these values.
+// | As long as none of them changes, it is not checked again.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::park( sc_process_b* process_h, sc_process_b* blocker_h )
+{
+    process_h->m_blocker_p = blocker_h;
+    process_h->m_blocker_time = blocker_h->m_process_state == 2 ?
+        blocker_h->possible_wakeup_time : blocker_h->get_timestamp();
+    process_h->m_blocker_state = blocker_h->m_process_state;
+    process_h->m_blocker_seg_id = blocker_h->get_segment_id();
+    process_h->m_blocker_inst_id = blocker_h->get_instance_id();
+    process_h->m_parked_time = process_h->get_timestamp();
+    process_h->m_parked_seg_id = process_h->get_segment_id();
+    process_h->m_parked_epoch = m_park_epoch;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::is_parked"
+// +----------------------------------------------------------------------------
+bool
+sc_simcontext::is_parked( sc_process_b* process_h )
+{
+    sc_process_b* blocker_h = process_h->m_blocker_p;
+    if ( blocker_h == 0 || process_h->m_parked_epoch != m_park_epoch )
+        return false;
+
+    return blocker_h->m_process_state == process_h->m_blocker_state
+        && ( blocker_h->m_process_state == 2 ?
+                 blocker_h->possible_wakeup_time : blocker_h->get_timestamp() )
+           == process_h->m_blocker_time
+        && blocker_h->get_segment_id() == process_h->m_blocker_seg_id
+        && blocker_h->get_instance_id() == process_h->m_blocker_inst_id
+        && process_h->get_timestamp() == process_h->m_parked_time
+        && process_h->get_segment_id() == process_h->m_parked_seg_id;
+}
+
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::update_conflict_filter"
+// | 
+// | A process is counted in the active set of the conflict filter at the 
+// | combined data conflict table index of its current segment and instance,
+// | unless it has finished.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::update_conflict_filter( sc_process_b* process_h )
+{
+    if ( !m_conflict_filter_p || !m_conflict_filter_p->is_built() )
+        return;
+
+    int seg_id = process_h->get_segment_id();
+    int inst_id = process_h->get_instance_id();
+    int id = -1;
+    if ( process_h->m_process_state != 4 && seg_id >= 0 && inst_id >= 0 )
+    {
+        id = combined_data_conflict_table_index_lookup( seg_id, inst_id );
+        assert( id >= 0 && (std::size_t)id < m_conflict_filter_p->size() );
+    }
+    if ( id == process_h->m_conflict_filter_id )
+        return;
+
+    if ( process_h->m_conflict_filter_id >= 0 )
+        m_conflict_filter_p->deactivate( process_h->m_conflict_filter_id );
+    if ( id >= 0 )
+        m_conflict_filter_p->activate( id );
+    process_h->m_conflict_filter_id = id;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::post_notification"
+// | 
+// | A running process notifies an event without waiting for the kernel 
+// | lock: the notification goes into the post queue of the process and is 
+// | applied by drain_notifications() when the lock is acquired next (see 
+// | sc_kernel_lock) or oooschedule() is entered. A process whose queue was 
+// | empty also pushes itself onto a lock-free stack of processes with posts,
+// | once per drain. Only the holder of the kernel lock drains, by taking the
+// | whole stack at once, so the pushes cannot suffer from ABA. Returns false
+// | if the queue is full; the caller then takes the kernel lock.
+// +----------------------------------------------------------------------------
+bool
+sc_simcontext::post_notification( sc_event* event_p, sc_process_b* proc_p,
+                                  const sc_time& t )
+{
+    sc_notify_post_queue& queue = proc_p->m_notify_posts;
+
+    __atomic_add_fetch( &event_p->m_posted, 1, __ATOMIC_RELAXED );
+    if ( !queue.push( event_p, proc_p->get_timestamp(), t ) )
+    {
+        __atomic_sub_fetch( &event_p->m_posted, 1, __ATOMIC_RELAXED );
+        return false;
+    }
+
+    // the drain clears m_pending before it reads the queue, so either it
+    // sees this post or the process is pushed again
+    if ( !__atomic_exchange_n( &queue.m_pending, true, __ATOMIC_ACQ_REL ) )
+    {
+        queue.m_next_p = __atomic_load_n( &m_notify_posts, __ATOMIC_RELAXED );
+        while ( !__atomic_compare_exchange_n( &m_notify_posts,
+                                              &queue.m_next_p, proc_p, true,
+                                              __ATOMIC_RELEASE,
+                                              __ATOMIC_RELAXED ) )
+            ;
+    }
+    return true;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::drain_notifications"
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::drain_notifications()
+{
+    // assume we have acquired the kernel lock upon here
+#ifdef SC_LOCK_CHECK
+    assert( is_locked_and_owner() );
+#endif /* SC_LOCK_CHECK */
+
+    if ( __atomic_load_n( &m_notify_posts, __ATOMIC_RELAXED ) == 0 )
+        return;
+    sc_process_b* proc_p = __atomic_exchange_n( &m_notify_posts,
+                               (sc_process_b*)0, __ATOMIC_ACQUIRE );
+
+    // each queue is applied in posting order; the processes that posted
+    // concurrently are not ordered among themselves
+    while ( proc_p )
+    {
+        sc_notify_post_queue& queue = proc_p->m_notify_posts;
+        sc_process_b* next_p = queue.m_next_p; // before it may be pushed again
+        __atomic_exchange_n( &queue.m_pending, false, __ATOMIC_ACQ_REL );
+
+        const sc_notify_post_queue::post* post_p;
+        while ( ( post_p = queue.front() ) != 0 )
+        {
+            post_p->m_event_p->apply_notification( proc_p,
+                                                   post_p->m_proc_ts,
+                                                   post_p->m_delay );
+            __atomic_sub_fetch( &post_p->m_event_p->m_posted, 1,
+                                __ATOMIC_RELEASE );
+            queue.pop();
+        }
+        proc_p = next_p;
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::place_process"
+// | 
+// | This method pins the thread of thread_h according to the SYSC_AFFINITY
+// | placement mode. In the module mode, processes of the same instance go to
+// | the same NUMA node, unless by_instance is false. A thread placed before
+// | its first dispatch is created on its CPU, so a fresh stack is first 
+// | touched, and allocated, on that node; a stack reused from the stack 
+// | pool stays where it was first touched.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::place_process( sc_thread_handle thread_h, bool by_instance )
+{
+    if ( m_affinity_p->mode() == SC_AFFINITY_NONE || thread_h->m_cor_p == 0 )
+        return;
+    int cpu = m_affinity_p->next_cpu( by_instance ?
+                                      thread_h->get_instance_id() : -1 );
+    if ( cpu >= 0 )
+        m_cor_pkg->set_affinity( thread_h->m_cor_p, cpu );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::may_conflict_with_active"
+// | 
+// | This method tests the conflict row of the segment of process_h against
+// | the active set. A conflict found by conflict_between_with_prediction()
+// | needs a non-zero combined table entry with a process that has not 
+// | finished, so false here means that process_h has no conflicts.
+// +----------------------------------------------------------------------------
+bool
+sc_simcontext::may_conflict_with_active( sc_process_b* process_h )
+{
+    if ( !m_conflict_filter_p->is_built() )
+        return true;
+
+    int seg_id = process_h->get_segment_id();
+    int inst_id = process_h->get_instance_id();
+    if ( seg_id < 0 || inst_id < 0 )
+        return false;
+
+    int id = combined_data_conflict_table_index_lookup( seg_id, inst_id );
+    return m_conflict_filter_p->may_conflict( id,
+               process_h->m_conflict_filter_id );
+}
 
 int
 sc_simcontext::combined_data_conflict_table_index_lookup( int seg_id, int inst_id )
@@ -3417,8 +3982,7 @@ sc_simcontext::conflict_between_two_segs(
     int CDCT_id = combined_data_conflict_table_index_lookup( seg_id, inst_id );
     int CDCT_id1 = combined_data_conflict_table_index_lookup( seg_id1, inst_id1 );
 
-    int N=sqrt(_OoO_Combined_Data_Conflict_Table_Size); //this should be changed. 
-    int m = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * N + CDCT_id] - 1;
+    int m = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id) - 1;
     
     if( m == -1)
     {
@@ -3572,8 +4136,8 @@ sc_simcontext::conflict_between( sc_process_b* process_h1,
     assert( conflict_table_index2 < _OoO_Data_Conflict_Table_Size );
 
     // check data hazards
-    if ( _OoO_Data_Conflict_Table[conflict_table_index1 * 
-             _OoO_Data_Conflict_Table_Size + conflict_table_index2] )
+    if ( _OoO_Data_Conflict_Matrix.test( conflict_table_index1,
+                                         conflict_table_index2 ) )
         return true;
     
     
@@ -3615,8 +4179,8 @@ sc_simcontext::conflict_between( sc_process_b* process_h1,
                                             inst_id3 );
                 assert( conflict_table_index3 < _OoO_Data_Conflict_Table_Size );
                 // if seg2 notifies seg3
-                if ( _OoO_Event_Notify_Table[conflict_table_index2 * 
-                         _OoO_Event_Notify_Table_Size + conflict_table_index3] )
+                if ( _OoO_Event_Notify_Matrix.test( conflict_table_index2,
+                                                    conflict_table_index3 ) )
                     return true;
             }
 
@@ -3637,8 +4201,8 @@ sc_simcontext::conflict_between( sc_process_b* process_h1,
                                             inst_id3 );
                 assert( conflict_table_index3 < _OoO_Data_Conflict_Table_Size );
                 // if seg2 notifies seg3
-                if ( _OoO_Event_Notify_Table[conflict_table_index2 * 
-                         _OoO_Event_Notify_Table_Size + conflict_table_index3] )
+                if ( _OoO_Event_Notify_Matrix.test( conflict_table_index2,
+                                                    conflict_table_index3 ) )
                     return true;
             }
 
@@ -3659,8 +4223,8 @@ sc_simcontext::conflict_between( sc_process_b* process_h1,
                                             inst_id3 );
                 assert( conflict_table_index3 < _OoO_Data_Conflict_Table_Size );
                 // if seg2 notifies seg3
-                if ( _OoO_Event_Notify_Table[conflict_table_index2 * 
-                         _OoO_Event_Notify_Table_Size + conflict_table_index3] )
+                if ( _OoO_Event_Notify_Matrix.test( conflict_table_index2,
+                                                    conflict_table_index3 ) )
                     return true;
             }
 
@@ -3681,8 +4245,8 @@ sc_simcontext::conflict_between( sc_process_b* process_h1,
                                             inst_id3 );
                 assert( conflict_table_index3 < _OoO_Data_Conflict_Table_Size );
                 // if seg2 notifies seg3
-                if ( _OoO_Event_Notify_Table[conflict_table_index2 * 
-                         _OoO_Event_Notify_Table_Size + conflict_table_index3] )
+                if ( _OoO_Event_Notify_Matrix.test( conflict_table_index2,
+                                                    conflict_table_index3 ) )
                     return true;
             }
         }
@@ -3704,7 +4268,18 @@ sc_simcontext::get_curr_proc() const
 void
 sc_simcontext::acquire_sched_mutex()
 {
-    if ( m_cor_pkg ) // m_cor_pkg is 0 in the elaboration phase
+    if ( m_cor_pkg && SC_UNLIKELY_( m_profile_p != 0 ) )
+    {
+        // only time a contended acquisition
+        bool contended = !m_cor_pkg->try_acquire_sched_mutex();
+        cycles_t start_cycles = currentcycles();
+        if ( contended )
+            m_cor_pkg->acquire_sched_mutex();
+        cycles_t now = currentcycles();
+        m_profile_p->kernel_lock_acquired( contended, now - start_cycles, 
+                                           now );
+    }
+    else if ( m_cor_pkg ) // m_cor_pkg is 0 in the elaboration phase
         m_cor_pkg->acquire_sched_mutex();
     else
         assert( !m_elaboration_done ); // being in the elaboration phase
@@ -3713,6 +4288,8 @@ sc_simcontext::acquire_sched_mutex()
 void
 sc_simcontext::release_sched_mutex()
 {
+    if ( m_cor_pkg && SC_UNLIKELY_( m_profile_p != 0 ) )
+        m_profile_p->kernel_lock_released( currentcycles() );
     if ( m_cor_pkg ) // m_cor_pkg is 0 in the elaboration phase
         m_cor_pkg->release_sched_mutex();
     else
@@ -3724,7 +4301,61 @@ sc_simcontext::release_sched_mutex()
 void
 sc_simcontext::suspend_cor( sc_cor* cor_p )
 {
-    m_cor_pkg->wait( cor_p );
+    m_handoff_enabled = false;
+    // the kernel lock is released while suspended
+    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+        m_profile_p->kernel_lock_released( currentcycles() );
+    if ( m_handoff_cor != 0 )
+    {
+        sc_cor* next_cor_p = m_handoff_cor;
+        m_handoff_cor = 0;
+        m_cor_pkg->handoff( cor_p, next_cor_p );
+    }
+    else
+        m_cor_pkg->wait( cor_p );
+    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+        m_profile_p->kernel_lock_acquired( false, 0, currentcycles() );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::enable_handoff"
+// | 
+// | A process that is about to suspend calls this before oooschedule(). If
+// | oooschedule() then issues exactly one coroutine, it is not resumed right
+// | away, but by suspend_cor() of the calling process, which hands the CPU 
+// | over to it directly. As soon as a second coroutine is issued, both are 
+// | resumed as usual.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::enable_handoff()
+{
+    assert( m_handoff_cor == 0 );
+    m_handoff_enabled = true;
+}
+
+void
+sc_simcontext::resume_issued_cor( sc_cor* cor_p )
+{
+    if ( m_handoff_enabled && m_handoff_cor == 0 )
+    {
+        m_handoff_cor = cor_p;
+        return;
+    }
+    resume_handoff_cor();
+    m_cor_pkg->go( cor_p );
+}
+
+// resume the deferred coroutine without handing over, e.g. because the 
+// calling process was issued again itself
+void
+sc_simcontext::resume_handoff_cor()
+{
+    m_handoff_enabled = false;
+    if ( m_handoff_cor != 0 )
+    {
+        m_cor_pkg->go( m_handoff_cor );
+        m_handoff_cor = 0;
+    }
 }
 
 void
@@ -3888,19 +4519,203 @@ void
 sc_simcontext::update_oldest_time( sc_time& curr_time )
 {
 if (  _SYSC_SYNC_PAR_SIM==true ){ //DM 08/16/2019 
-    sc_time proc_time;
-
-    if ( curr_time == m_oldest_time ) {
-        m_oldest_time = m_all_proc.front()->get_timestamp().get_time_count();
-        for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin(); 
-              it != m_all_proc.end(); ++it ) {
-            proc_time = (*it)->get_timestamp().get_time_count();
-            if ( proc_time < m_oldest_time ) {
-                m_oldest_time = proc_time;
-            }
+    sc_timestamp oldest_ts;
+
+    if ( curr_time == m_oldest_time &&
+         earliest_process_time( m_time_heap_p, 0, oldest_ts ) ) {
+        m_oldest_time = oldest_ts.get_time_count();
+    }
+}
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::push_synch_process"
+// | 
+// | This method queues a process that waits for the synchronized time to 
+// | advance. A queued process keeps its time stamp until it is released.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::push_synch_process( sc_process_b* process_h )
+{
+    m_synch_heap_p->push( process_h, process_h->get_timestamp() );
+    track_process( process_h );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::index_process"
+// | 
+// | This method pushes a process onto both lazy process heaps whenever its 
+// | time stamp changes or it becomes ready. Its old entries stay until they 
+// | reach the top (see earliest_process_time). Once the heaps hold more 
+// | than twice as many entries as there are processes, they are refilled.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::index_process( sc_process_b* process_h )
+{
+    if ( process_h->invoker ) // the invokers are not in m_all_proc
+        return;
+
+    sc_process_heaps_lock lock( m_process_heaps_mutex );
+    if ( m_time_heap_p->size() > m_process_heap_limit )
+    {
+        fill_process_heaps();
+        return;
+    }
+    m_time_heap_p->push( process_h, process_h->get_timestamp() );
+    m_active_heap_p->push( process_h, process_h->get_timestamp() );
+    m_notify_heap_p->push( process_h, process_h->get_timestamp() );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::rebuild_process_heaps"
+// | 
+// | This method builds the process heaps on their first use. From then on, 
+// | the processes keep them up to date through track_process().
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::rebuild_process_heaps()
+{
+    sc_process_heaps_lock lock( m_process_heaps_mutex );
+    fill_process_heaps();
+    m_process_heaps_built = true;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::fill_process_heaps"
+// | 
+// | This method refills the process heaps from m_all_proc. The mutex of the
+// | process heaps must be held.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::fill_process_heaps()
+{
+    m_time_heap_p->clear();
+    m_active_heap_p->clear();
+    m_notify_heap_p->clear();
+    for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin();
+          it != m_all_proc.end(); ++it )
+    {
+        m_time_heap_p->push( *it, (*it)->get_timestamp() );
+        if ( is_active_process( *it ) )
+            m_active_heap_p->push( *it, (*it)->get_timestamp() );
+        if ( holds_notifications( *it ) )
+            m_notify_heap_p->push( *it, (*it)->get_timestamp() );
+    }
+    m_process_heap_limit = 2 * m_time_heap_p->size() + 64;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::holds_notifications"
+// +----------------------------------------------------------------------------
+bool
+sc_simcontext::holds_notifications( sc_process_b* process_h )
+{
+    return is_active_process( process_h ) ||
+           ( process_h->m_process_state == 2 &&
+             process_h->m_event_list_p != NULL &&
+             process_h->m_event_list_p->and_list() );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::set_possible_wakeup_time"
+// | 
+// | This method sets the possible wake-up time of a process and pushes it 
+// | onto the lazy wake-up heap. Its old entry stays; push_waiting_before() 
+// | skips it, since the process has another time now. Once the heap holds 
+// | more than twice as many entries as there are processes, it is refilled.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::set_possible_wakeup_time( sc_process_b* process_h,
+                                         const sc_timestamp& ts )
+{
+    if ( process_h->possible_wakeup_time == ts )
+        return;
+    process_h->possible_wakeup_time = ts;
+
+    // an infinite time is never earlier, and the invokers are not in 
+    // m_all_proc
+    if ( ts.get_infinite() || process_h->invoker )
+        return;
+
+    if ( m_wakeup_heap_p->size() > m_wakeup_heap_limit )
+    {
+        m_wakeup_heap_p->clear();
+        for ( std::list<sc_process_b*>::iterator it = m_all_proc.begin();
+              it != m_all_proc.end(); ++it )
+        {
+            if ( !(*it)->possible_wakeup_time.get_infinite() )
+                m_wakeup_heap_p->push( *it, (*it)->possible_wakeup_time );
         }
+        m_wakeup_heap_limit = 2 * m_all_proc.size() + 64;
+        return;
     }
+    m_wakeup_heap_p->push( process_h, ts );
 }
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::push_waiting_before"
+// | 
+// | This method appends the waiting processes whose possible wake-up time 
+// | is earlier than ts. Only the heap entries earlier than ts are visited. 
+// | A process may have several current entries with the same time; the 
+// | mark makes sure it is appended once.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::push_waiting_before( const sc_timestamp& ts,
+                                    std::list<sc_process_b*>& procs )
+{
+    // drop the outdated entries on top
+    while ( !m_wakeup_heap_p->empty() &&
+            !( m_wakeup_heap_p->top().proc_p->possible_wakeup_time ==
+               m_wakeup_heap_p->top().ts ) )
+        m_wakeup_heap_p->pop();
+
+    m_wakeup_entries.clear();
+    m_wakeup_heap_p->collect_earlier( ts, m_wakeup_entries );
+    m_wakeup_mark++;
+    for ( std::size_t i = 0; i < m_wakeup_entries.size(); i++ )
+    {
+        sc_process_b* process_h = m_wakeup_entries[i]->proc_p;
+        if ( process_h->m_process_state == 2 &&
+             process_h->possible_wakeup_time == m_wakeup_entries[i]->ts &&
+             process_h->m_wakeup_mark != m_wakeup_mark )
+        {
+            process_h->m_wakeup_mark = m_wakeup_mark;
+            procs.push_back( process_h );
+        }
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::earliest_process_time"
+// | 
+// | This method returns the time stamp of the earliest process in a lazy 
+// | process heap. An entry on top whose process has moved on to another 
+// | time stamp (or is rejected by filter_p, e.g. is no longer running, 
+// | ready, waiting for time or synchronizing) is dropped: the process was 
+// | pushed again when it changed, or will be when it becomes ready.
+// +----------------------------------------------------------------------------
+bool
+sc_simcontext::earliest_process_time( sc_process_heap* heap_p, 
+                                      bool (*filter_p)( sc_process_b* ),
+                                      sc_timestamp& ts )
+{
+    if ( !m_process_heaps_built )
+        rebuild_process_heaps();
+
+    sc_process_heaps_lock lock( m_process_heaps_mutex );
+    while ( !heap_p->empty() )
+    {
+        const sc_process_heap::entry& top = heap_p->top();
+        if ( top.proc_p->get_timestamp() == top.ts &&
+             ( !filter_p || filter_p( top.proc_p ) ) )
+        {
+            ts = top.ts;
+            return true;
+        }
+        heap_p->pop();
+    }
+    return false;
 }
 
 #if 0
@@ -4084,7 +4899,10 @@ sc_simcontext::cycle( const sc_time& t)
 void
 sc_simcontext::elaborate()
 {
-    if(_OoO_Table_File_Name != NULL)
+    // a table file in the packed format is mapped, the scheduling tables
+    // are then used in place; otherwise it is read in the original format
+    if(_OoO_Table_File_Name != NULL && 
+       !sc_ooo_map_table_file(_OoO_Table_File_Name))
     {
         std::ifstream fin(_OoO_Table_File_Name);
         if(!fin.good())
@@ -4445,6 +5263,15 @@ sc_simcontext::elaborate()
             std::cout << "Still extra data in the table file" << std::endl;
             exit(1);
         }
+        sc_ooo_attach_table_arrays();
+    }
+    else if(_OoO_Table_File_Name == NULL)
+    {
+        sc_ooo_attach_table_arrays();
+    }
+    if(getenv(_SYSC_WRITE_PACKED_TABLE_FILE_ENV_VAR))
+    {
+        sc_ooo_write_table_file(getenv(_SYSC_WRITE_PACKED_TABLE_FILE_ENV_VAR));
     }
     if( m_elaboration_done || sim_status() != SC_SIM_OK ) {
         return;
@@ -4547,6 +5374,7 @@ sc_simcontext::prepare_to_simulate()
       thread_p; thread_p = thread_p->next_exist() )
     {
 	thread_p->prepare_for_simulation();
+	place_process( thread_p );
 	thread_p->possible_wakeup_time = sc_timestamp(-1,-1);
     }
 
@@ -4557,6 +5385,21 @@ sc_simcontext::prepare_to_simulate()
     {
     thread_p = (*invok_iter)->proc_handle;
     thread_p->prepare_for_simulation();
+    // an invoker runs the methods of all modules
+    place_process( thread_p, false );
+    }
+
+    // build the conflict rows and count all processes in the active set
+    m_conflict_filter_p->build( _OoO_Combined_Data_Conflict_Matrix );
+    for ( method_p = m_process_table->method_q_head(); 
+      method_p; method_p = method_p->next_exist() )
+    {
+        update_conflict_filter( method_p );
+    }
+    for ( thread_p = m_process_table->thread_q_head(); 
+      thread_p; thread_p = thread_p->next_exist() )
+    {
+        update_conflict_filter( thread_p );
     }
 
     //DM 07/28/2019 experiment
@@ -4564,7 +5407,6 @@ sc_simcontext::prepare_to_simulate()
     sc_method_handle  method_p2;  // Pointer to method process accessing.
     sc_thread_handle  thread_p2;
     int _OoO_Prediction_Event_Notification_Table_Size=sqrt(_OoO_Combined_Data_Conflict_Table_Size);
-    int Ncolumns_Data_Conflict_Table =sqrt(_OoO_Combined_Data_Conflict_Table_Size); //this should be changed. 
     for ( method_p1 = m_process_table->method_q_head(); 
 	  method_p1; method_p1 = method_p1->next_exist() )
     {
@@ -4595,7 +5437,7 @@ sc_simcontext::prepare_to_simulate()
 	    int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    int table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * Ncolumns_Data_Conflict_Table + CDCT_id];
+	    int table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id);
 	    if(table_entry > 0) {
 	    	method_p2->combined_data_conflict_methods.insert(method_p1);
 	    }
@@ -4626,7 +5468,7 @@ sc_simcontext::prepare_to_simulate()
 	    int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    int table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * Ncolumns_Data_Conflict_Table + CDCT_id];
+	    int table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id);
 	    if(table_entry > 0) {
 	    	thread_p2->combined_data_conflict_methods[thread_p2->get_segment_id()].insert(method_p1);
 	    }
@@ -4668,7 +5510,7 @@ sc_simcontext::prepare_to_simulate()
 	    int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    int table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * Ncolumns_Data_Conflict_Table + CDCT_id];
+	    int table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id);
 	    if(table_entry > 0) {
 	    	method_p2->combined_data_conflict_threads.insert(thread_p1);
 	    }
@@ -4699,7 +5541,7 @@ sc_simcontext::prepare_to_simulate()
 	    int CDCT_id = combined_data_conflict_table_index_lookup( it2_seg, it2_inst );
 	    int CDCT_id1 = combined_data_conflict_table_index_lookup( it1_seg, it1_inst );
 
-	    int table_entry = _OoO_Combined_Data_Conflict_Table[CDCT_id1 * Ncolumns_Data_Conflict_Table + CDCT_id];
+	    int table_entry = _OoO_Combined_Data_Conflict_Matrix.get(CDCT_id1, CDCT_id);
 	    if(table_entry > 0) {
 	    	thread_p2->combined_data_conflict_threads[thread_p2->get_segment_id()].insert(thread_p1);
 	    }
@@ -5100,8 +5942,8 @@ sc_simcontext::simulate( const sc_time& duration )
     {
 	if(_SYSC_SYNC_PAR_SIM==true)
 	{
-	    m_synch_thread_queue.push_back( *process_it );
 	    ( *process_it )->m_process_state=32;
+	    push_synch_process( *process_it );
 	}
 	else
 	{
@@ -5229,6 +6071,10 @@ sc_simcontext::end()
     m_module_registry->simulation_done();
     SC_DO_PHASE_CALLBACK_(simulation_done);
     m_end_of_simulation_called = true;
+    if ( m_profile_p )
+        m_profile_p->write( sc_profile::file_name() );
+    if ( m_issue_log_p )
+        m_issue_log_p->flush();
 }
 
 void
@@ -5301,11 +6147,13 @@ sc_simcontext::create_cthread_process(
 
     // 12/22/2016 GL: add this cthread to m_all_proc
     m_all_proc.push_back( handle );
+    track_process( handle );
     m_oldest_time = sc_time();
 
     if ( m_ready_to_simulate ) 
     {
         handle->prepare_for_simulation();
+        place_process( handle );
     } else {
         m_process_table->push_front( handle );
     }
@@ -5330,10 +6178,12 @@ sc_simcontext::create_thread_process(
 
     // 12/22/2016 GL: add this thread to m_all_proc
     m_all_proc.push_back( handle );
+    track_process( handle );
     m_oldest_time = sc_time();
 
     if ( m_ready_to_simulate ) { // dynamic process
         handle->prepare_for_simulation();
+        place_process( handle );
         if ( !handle->dont_initialize() )
         {
 #ifdef SC_HAS_PHASE_CALLBACKS_
@@ -6017,8 +6867,6 @@ sc_simcontext::create_method_process(
 
 
 
-static int method_count = 0;
-
 static bool init = false;
 if(!init) {
 init = true;
@@ -6027,6 +6875,7 @@ set_number_sim_cpus();
 		std::stringstream invok_strstr;
 		invok_strstr << "invoker" << i;
 		Invoker* new_invoker = new Invoker(invok_strstr.str().c_str());
+		new_invoker->m_index = m_invokers.size();
 		m_invokers.push_back(new_invoker);
 	}
 
@@ -6042,10 +6891,7 @@ m_invokers.push_back(new_invoker);
 
 	((sc_process_b*)handle)->m_trigger_type = sc_process_b::STATIC;
 
-	//method_to_invoker_map[ (sc_process_b*)handle ] = m_invokers[ m_invokers.size()-1];
-
-    	method_to_invoker_map[ (sc_process_b*)handle ] = m_invokers[ method_count % _SYSC_NUM_INVOKERS ];
-	method_count++;
+	// methods are assigned to idle invokers when they are issued
 
     // 08/17/2015 GL: set the starting segment ID of this thread
     handle->set_segment_id( seg_id );
@@ -6055,6 +6901,7 @@ m_invokers.push_back(new_invoker);
 
     // 12/22/2016 GL: add this thread to m_all_proc
     m_all_proc.push_back( handle );
+    track_process( handle );
     m_oldest_time = sc_time();
 
     if ( m_ready_to_simulate ) { // dynamic process
@@ -6104,6 +6951,7 @@ m_invokers.push_back(new_invoker);
 
     // 12/22/2016 GL: add this method to m_all_proc
     m_all_proc.push_back( handle );
+    track_process( handle );
     m_oldest_time = sc_time();
 
     if ( m_ready_to_simulate ) { // dynamic process
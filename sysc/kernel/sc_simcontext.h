@@ -34,6 +34,7 @@
 #include "sysc/kernel/sc_time.h"
 #include "sysc/utils/sc_hash.h"
 #include "sysc/utils/sc_pq.h"
+#include "sysc/kernel/sc_timed_event_queue.h"
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -69,6 +70,12 @@ class sc_process_table;
 class sc_signal_bool_deval;
 class sc_trace_file;
 class sc_runnable;
+class sc_ooo_conflict_filter;
+class sc_affinity;
+class sc_profile;
+class sc_issue_log;
+class sc_process_heap;
+struct sc_process_heap_entry;
 class sc_process_host;
 class sc_method_process;
 class sc_cthread_process;
@@ -435,6 +442,11 @@ public:
     sc_object* find_object( const char* name );
 
     sc_module_registry* get_module_registry();
+
+    /**
+     *  \brief The scheduler profile, 0 unless _SYSC_PROFILE_ENV_VAR is set.
+     */
+    const sc_profile* get_profile() const;
     sc_port_registry* get_port_registry();
     sc_export_registry* get_export_registry();
     sc_prim_channel_registry* get_prim_channel_registry();
@@ -556,6 +568,11 @@ public:
     // 11/05/2014 GL.
     void remove_running_process( sc_process_b* );
 
+    /**
+     *  \brief Remove a batch of processes from the running queue.
+     */
+    void remove_running_processes( std::vector<sc_process_b*>& );
+
     /**
      *  \brief Check whether a process is in the running queue.
      */
@@ -574,6 +591,23 @@ public:
     // 11/05/2014 GL.
     void resume_cor( sc_cor* );
 
+    /**
+     *  \brief Let the calling process hand over directly to the only 
+     *         coroutine issued by the next oooschedule(), in suspend_cor().
+     */
+    void enable_handoff();
+
+    /**
+     *  \brief Resume a coroutine issued by oooschedule(), or defer it for
+     *         a handoff.
+     */
+    void resume_issued_cor( sc_cor* );
+
+    /**
+     *  \brief Resume the coroutine deferred for a handoff, if any.
+     */
+    void resume_handoff_cor();
+
     /**
      *  \brief Check whether the kernel lock is acquired.
      */
@@ -627,6 +661,8 @@ private:
     void predict_wakeup_time_by_running_ready_threads();
     void predict_wakeup_time_by_events(
 	std::unordered_map<sc_process_b*, std::unordered_map<sc_event*, sc_timestamp> >& wkup_t_evnt);
+    void predict_wakeup_time_by_event( sc_event*, sc_process_b*,
+	std::unordered_map<sc_process_b*, std::unordered_map<sc_event*, sc_timestamp> >& wkup_t_evnt);
     void predict_wakeup_time_by_waiting_threads(
         std::unordered_map<sc_process_b*, std::unordered_map<sc_event*, sc_timestamp> >& wkup_t_evnt);
 //	std::unordered_map<sc_process_b*, sc_timestamp>& wkup_t_pred_and_evnt,
@@ -702,9 +738,58 @@ private:
      *  \brief The dynamic conflict detection function.
      */
     // 08/17/2015 GL.
-    bool has_no_conflicts( sc_process_b*, std::list<sc_method_handle>, std::list<sc_thread_handle> );
+    bool has_no_conflicts( sc_process_b*, const std::list<sc_method_handle>&, const std::list<sc_thread_handle>& );
     //DM 07/31/2019 experiment
-    bool has_no_conflicts_method( sc_process_b*, std::list<sc_method_handle>, std::list<sc_thread_handle> );
+    bool has_no_conflicts_method( sc_process_b*, const std::list<sc_method_handle>&, const std::list<sc_thread_handle>& );
+
+    /**
+     *  \brief Park a ready process on the process it conflicts with.
+     */
+    void park( sc_process_b* process_h, sc_process_b* blocker_h );
+
+    /**
+     *  \brief Whether process_h is parked and neither it nor its blocker
+     *         changed since, so that it still conflicts.
+     */
+    bool is_parked( sc_process_b* process_h );
+
+    /**
+     *  \brief Drop all parkings, e.g. before a process is deleted.
+     */
+    void unpark_all() { m_park_epoch++; }
+
+    /**
+     *  \brief Recount a process in the conflict filter after its segment,
+     *         instance or state changed.
+     */
+    void update_conflict_filter( sc_process_b* );
+
+    /**
+     *  \brief Whether the segment of process_h may conflict with any active
+     *         process. If not, the pairwise checks can be skipped.
+     */
+    bool may_conflict_with_active( sc_process_b* process_h );
+
+    /**
+     *  \brief Post a notification of event_p by the running process proc_p
+     *         without acquiring the kernel lock. Returns false if the post
+     *         queue of proc_p is full.
+     */
+    bool post_notification( sc_event* event_p, sc_process_b* proc_p,
+                            const sc_time& t );
+
+    /**
+     *  \brief Apply all posted notifications, those of each process in the
+     *         order they were posted.
+     */
+    void drain_notifications();
+
+    /**
+     *  \brief Pin the thread of a process to the CPU chosen by the
+     *         SYSC_AFFINITY placement mode, if any. by_instance is false
+     *         for threads not bound to one module instance.
+     */
+    void place_process( sc_thread_handle thread_h, bool by_instance = true );
 
   /**
      *  \brief use index id to get segment id.
@@ -759,7 +844,31 @@ private:
      */
     // 10:54 2017/3/10 ZC.
   void add_to_wait_queue( sc_process_b*) ;
+  void add_to_wait_queue( const std::vector<sc_process_b*>& ) ;
   void remove_from_wait_queue(sc_process_b*) ;
+
+    /**
+     *  \brief Hand the methods issued by oooschedule() to the idle invokers
+     *         as timestamp-homogeneous batches.
+     */
+    void issue_method_wave();
+
+    /**
+     *  \brief Print how often each invoker was woken up, how many methods
+     *         it ran and stole, and its share of the elapsed cycles.
+     */
+    void print_invoker_stats( unsigned long long elapsed_cycles );
+
+    /**
+     *  \brief Record in the profile that a process was not issued, and by
+     *         which segment it was held back (m_conflict_blocker_p).
+     */
+    void profile_blocked( sc_process_b* process_h );
+
+    /**
+     *  \brief Record in the profile that a process stopped running.
+     */
+    void profile_finished( sc_process_b* process_h );
   
     /**
      *  \brief Detect conflicts between two processes.
@@ -773,6 +882,69 @@ private:
     // 12/22/2016 GL.
     void update_oldest_time( sc_time& curr_time );
 
+    /**
+     *  \brief Index a process whose time stamp or state changed, once the
+     *         process heaps are in use.
+     */
+    inline void track_process( sc_process_b* process_h );
+
+    /**
+     *  \brief Push a process onto the queue of synchronizing processes.
+     */
+    void push_synch_process( sc_process_b* process_h );
+
+    /**
+     *  \brief Push a process onto the process heaps.
+     */
+    void index_process( sc_process_b* process_h );
+
+    /**
+     *  \brief Refill the process heaps from m_all_proc.
+     */
+    void rebuild_process_heaps();
+    void fill_process_heaps();
+
+    /**
+     *  \brief Whether a process is running (0), ready (1), waiting for time
+     *         (3) or synchronizing (32).
+     */
+    static bool is_active_process( sc_process_b* process_h )
+    {
+        int state = process_h->m_process_state;
+        return state == 0 || state == 1 || state == 3 || state == 32;
+    }
+
+    /**
+     *  \brief Whether the time stamp of a process keeps the event
+     *         notifications after it: an active process, or one waiting
+     *         for an and-list of events (see
+     *         clean_up_old_event_notifications).
+     */
+    static bool holds_notifications( sc_process_b* process_h );
+
+    /**
+     *  \brief The earliest time stamp in a process heap, dropping the
+     *         outdated entries on top. With a filter, only the processes it
+     *         accepts count.
+     */
+    bool earliest_process_time( sc_process_heap* heap_p,
+                                bool (*filter_p)( sc_process_b* ),
+                                sc_timestamp& ts );
+
+    /**
+     *  \brief Set the possible wake-up time of a process and index it in
+     *         the wake-up heap.
+     */
+    void set_possible_wakeup_time( sc_process_b* process_h,
+                                   const sc_timestamp& ts );
+
+    /**
+     *  \brief Append the waiting processes with a possible wake-up time
+     *         earlier than ts, each once.
+     */
+    void push_waiting_before( const sc_timestamp& ts,
+                              std::list<sc_process_b*>& procs );
+
 
 private:
 
@@ -814,12 +986,28 @@ private:
     std::vector<sc_object*>     m_child_objects;
 
     std::vector<sc_event*>      m_delta_events;
-    sc_ppq<sc_event_timed*>*    m_timed_events;
+    sc_timed_event_queue*       m_timed_events;
   
     std::vector<sc_trace_file*> m_trace_files;
     bool                        m_something_to_trace;
   
     sc_runnable*                m_runnable;
+
+    // per-segment conflict rows and the set of active segments, built in
+    // prepare_to_simulate() and only used with prediction enabled
+    sc_ooo_conflict_filter*     m_conflict_filter_p;
+    sc_process_b*               m_notify_posts; // processes with posted
+                                                // notifications, latest
+                                                // first
+    sc_affinity*                m_affinity_p;   // CPU placement of the
+                                                // simulation threads
+    sc_profile*                 m_profile_p;    // scheduler profile, 0 if
+                                                // not profiling
+    sc_issue_log*               m_issue_log_p;  // issue decisions recorded
+                                                // or replayed, 0 if neither
+    sc_process_b*               m_conflict_blocker_p; // process the last
+                                                // failed conflict check
+                                                // ran into
     sc_process_list*            m_collectable;
 
     sc_time_params*             m_time_params;
@@ -876,7 +1064,19 @@ private:
   
 public:
   //std::list<sc_thread_handle>    m_synch_thread_queue;
-  std::list<sc_process_b*>    m_synch_thread_queue; //DM 05/27/2019 synch queue now includes both threads and methods
+  //DM 05/27/2019 synch queue now includes both threads and methods
+  sc_process_heap*            m_synch_heap_p; // synchronizing processes,
+                                              // oldest first
+  sc_process_heap*            m_active_heap_p; // running, ready and
+                                              // synchronizing processes
+  sc_process_heap*            m_time_heap_p;  // all of m_all_proc
+  sc_process_heap*            m_notify_heap_p; // processes that hold event
+                                              // notifications
+  bool                        m_process_heaps_built;
+  std::size_t                 m_process_heap_limit; // entries before the
+                                              // heaps are refilled
+  CHNL_MTX_TYPE_              m_process_heaps_mutex; // invokers set time
+                                              // stamps without the kernel lock
 
     // 12/22/2016 GL: a list of all threads and methods created in simulation
     std::list<sc_process_b*>    m_all_proc;
@@ -899,8 +1099,9 @@ public:
 
 private:
 //05/15/2019 DM TODO: use C++11 data structures
-std::unordered_map<sc_process_b*,Invoker*> method_to_invoker_map;
 std::vector<Invoker*> m_invokers;
+std::vector<Invoker*> m_idle_invokers; // scratch list of oooschedule()
+std::vector<sc_process_b*> m_method_wave; // methods issued by oooschedule()
 std::unordered_set<Invoker*> ready_invokers;
 std::unordered_set<Invoker*> running_invokers;
 //bool check_and_deliver_events_now;
@@ -914,6 +1115,21 @@ pthread_mutex_t kernel_request_mutex;
 std::list<sc_process_b*> new_waiting_proc;
 std::unordered_set<sc_process_b*> mod_wakeup_proc;
 std::unordered_set<sc_process_b*> defining_tree;
+//evaluate all waiters in the next predict_wakeup_time_by_events() call
+bool m_wakeup_full_scan;
+//processes by possible wake-up time; an entry whose process has another one
+//is outdated (see set_possible_wakeup_time)
+sc_process_heap* m_wakeup_heap_p;
+std::size_t m_wakeup_heap_limit;
+std::vector<const sc_process_heap_entry*> m_wakeup_entries;
+unsigned int m_wakeup_mark;
+//the time before which the event notifications were pruned last
+sc_timestamp m_notify_clean_time;
+//parkings made before the last unpark_all() are invalid
+unsigned int m_park_epoch;
+//the coroutine deferred for a handoff, see enable_handoff()
+sc_cor* m_handoff_cor;
+bool m_handoff_enabled;
 unsigned long long total_runrdycheck;
 unsigned long long total_eventcheck;
 unsigned long long total_waitcheck;
@@ -996,6 +1212,22 @@ sc_simcontext::get_module_registry()
     return m_module_registry;
 }
 
+inline
+const sc_profile*
+sc_simcontext::get_profile() const
+{
+    return m_profile_p;
+}
+
+inline
+void
+sc_simcontext::track_process( sc_process_b* process_h )
+{
+    // the heaps are built on their first use
+    if ( m_process_heaps_built )
+        index_process( process_h );
+}
+
 inline
 sc_port_registry*
 sc_simcontext::get_port_registry()
@@ -1127,6 +1359,8 @@ sc_simcontext::write_check() const
 inline void
 sc_simcontext::remove_running_process( sc_process_b* proc )
 {
+    if ( SC_UNLIKELY_( m_profile_p != 0 ) )
+        profile_finished( proc );
     m_curr_proc_queue.remove( proc );
 }
 
@@ -236,6 +236,7 @@ sc_simcontext::push_runnable_method( sc_method_handle method_h )
     }
     method_h->PWT_defining_proc = NULL;
     m_runnable->push_back_method( method_h );
+    track_process( method_h );
 }
 
 inline
@@ -252,6 +253,7 @@ sc_simcontext::push_runnable_method_front( sc_method_handle method_h )
     }
     method_h->PWT_defining_proc = NULL;
     m_runnable->push_front_method( method_h );
+    track_process( method_h );
 }
 
 inline
@@ -268,6 +270,7 @@ sc_simcontext::push_runnable_thread( sc_thread_handle thread_h )
     }
     thread_h->PWT_defining_proc = NULL;
     m_runnable->push_back_thread( thread_h );
+    track_process( thread_h );
 }
 
 inline
@@ -284,6 +287,7 @@ sc_simcontext::push_runnable_thread_front( sc_thread_handle thread_h )
     }
     thread_h->PWT_defining_proc = NULL;
     m_runnable->push_front_thread( thread_h );
+    track_process( thread_h );
 }
 
 
@@ -0,0 +1,111 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_stack_pool.cpp -- Pool of coroutine stacks, keyed by their size.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#if !defined(_WIN32) && !defined(WIN32) && defined(SC_USE_PTHREADS)
+
+#include "sysc/kernel/sc_stack_pool.h"
+
+#include <map>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace sc_core {
+
+// the free stacks by size; never destroyed, as a coroutine may be deleted
+// by a static destructor
+
+static pthread_mutex_t                               stack_mutex =
+    PTHREAD_MUTEX_INITIALIZER;
+static std::map<std::size_t, std::vector<char*> >*   free_stacks = 0;
+
+static std::size_t
+page_size()
+{
+    static std::size_t size = 0;
+    if ( size == 0 )
+        size = sysconf( _SC_PAGESIZE );
+    return size;
+}
+
+char*
+sc_stack_pool::allocate( std::size_t& size )
+{
+    std::size_t page = page_size();
+    size = ( size + page - 1 ) / page * page;
+
+    pthread_mutex_lock( &stack_mutex );
+    if ( free_stacks != 0 )
+    {
+        std::vector<char*>& stacks = (*free_stacks)[size];
+        if ( !stacks.empty() )
+        {
+            char* stack = stacks.back();
+            stacks.pop_back();
+            pthread_mutex_unlock( &stack_mutex );
+            return stack;
+        }
+    }
+    pthread_mutex_unlock( &stack_mutex );
+
+    // the guard page is the lowest one, the stacks grow down
+    void* base = mmap( 0, size + page, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if ( base == MAP_FAILED )
+        return 0;
+    mprotect( base, page, PROT_NONE );
+    return (char*)base + page;
+}
+
+void
+sc_stack_pool::release( char* stack, std::size_t size )
+{
+    if ( stack == 0 )
+        return;
+    pthread_mutex_lock( &stack_mutex );
+    if ( free_stacks == 0 )
+        free_stacks = new std::map<std::size_t, std::vector<char*> >;
+    (*free_stacks)[size].push_back( stack );
+    pthread_mutex_unlock( &stack_mutex );
+}
+
+} // namespace sc_core
+
+#endif // !defined(_WIN32) && !defined(WIN32) && defined(SC_USE_PTHREADS)
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -0,0 +1,81 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_stack_pool.h -- Pool of coroutine stacks, keyed by their size.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_STACK_POOL_H
+#define SC_STACK_POOL_H
+
+#if defined(SC_USE_PTHREADS)
+
+#include <cstddef>
+
+namespace sc_core {
+
+/**************************************************************************//**
+ *  \class sc_stack_pool
+ *
+ *  \brief Stacks for the coroutine packages, recycled by size.
+ *
+ *  A stack is mapped with an inaccessible guard page below it, and only its
+ *  touched pages take memory. A released stack is kept for the next
+ *  coroutine of the same (page rounded) size, so processes that are spawned
+ *  and terminate during simulation do not map and unmap a stack each.
+ *  The pool is shared by all threads.
+ *****************************************************************************/
+
+class sc_stack_pool
+{
+public:
+
+    /**
+     *  \brief A stack of at least size bytes, 0 if none can be mapped. size
+     *         is rounded up to whole pages.
+     */
+    static char* allocate( std::size_t& size );
+
+    /**
+     *  \brief Return a stack of allocate() for reuse. The stack must not be
+     *         in use by any thread any more.
+     */
+    static void release( char* stack, std::size_t size );
+};
+
+} // namespace sc_core
+
+#endif // defined(SC_USE_PTHREADS)
+
+#endif // SC_STACK_POOL_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -166,6 +166,7 @@ void sc_thread_cor_fn( void* arg )
 	//DM 08/15/2019
 	simc_p->new_waiting_proc.push_back(thread_h);	
 		thread_h->m_process_state=4;
+		simc_p->update_conflict_filter( thread_h );
         // 08/19/2015 GL: OoO scheduling
         //simc_p->schedule( thread_h->m_cor_p );
         simc_p->oooschedule( thread_h->m_cor_p );
@@ -1026,8 +1027,8 @@ bool sc_thread_process::deliver_event_at_time( sc_event* e,
         //push thread to ready queue
         if(_SYSC_SYNC_PAR_SIM==true){
 
-            simcontext()->m_synch_thread_queue.push_back(this);
             this->m_process_state=32;
+            simcontext()->push_synch_process(this);
  
         }else{
             simcontext()->push_runnable_thread(this);
@@ -1382,8 +1383,8 @@ bool sc_thread_process::trigger_dynamic( sc_event* e, bool& can_wake_up )
         //push thread to ready queue
         if(_SYSC_SYNC_PAR_SIM==true){
 
-            simcontext()->m_synch_thread_queue.push_back(this);
             this->m_process_state=32;
+            simcontext()->push_synch_process(this);
  
         }else{
             simcontext()->push_runnable_thread(this);
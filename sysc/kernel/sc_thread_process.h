@@ -340,6 +340,7 @@ inline void sc_thread_process::suspend_me()
     pthread_mutex_unlock( &sc_get_curr_simcontext()->kernel_request_mutex );
 
     if(cur_kernel_requests == 1) {
+    simc_p->enable_handoff();
     simc_p->oooschedule( m_cor_p ); // 08/19/2015 GL: OoO scheduling
     }
 
@@ -359,6 +360,8 @@ inline void sc_thread_process::suspend_me()
         simc_p->suspend_cor( m_cor_p );
         DEBUG_MSG( DEBUG_NAME , this, "resuming thread");
     }
+    else
+        simc_p->resume_handoff_cor();
 
     // IF THERE IS A THROW TO BE DONE FOR THIS PROCESS DO IT NOW:
     //
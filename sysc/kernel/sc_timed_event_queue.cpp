@@ -0,0 +1,334 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_timed_event_queue.cpp -- The queue of the timed event notifications: a
+                              binary heap or a calendar queue.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_timed_event_queue.h"
+#include "sysc/kernel/sc_event.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace sc_core {
+
+// the fewest buckets of a calendar, and its first slot width (1 ns at the
+// default time resolution)
+#define SC_CALENDAR_MIN_BUCKETS 16
+#define SC_CALENDAR_INIT_WIDTH  1000
+
+// the number of distinct times the slot width is estimated from
+#define SC_CALENDAR_WIDTH_SAMPLE 32
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_timed_event_queue
+// ----------------------------------------------------------------------------
+
+sc_timed_event_queue*
+sc_timed_event_queue::create()
+{
+    const char* env = std::getenv( _SYSC_TIMED_QUEUE_ENV_VAR );
+    if ( env == NULL || *env == 0 || std::strcmp( env, "heap" ) == 0 )
+        return create( SC_TIMED_QUEUE_HEAP );
+    if ( std::strcmp( env, "calendar" ) == 0 )
+        return create( SC_TIMED_QUEUE_CALENDAR );
+
+    std::cout << "Invalid value of " << _SYSC_TIMED_QUEUE_ENV_VAR << ": "
+              << env << " (heap or calendar)" << std::endl;
+    exit(1);
+}
+
+sc_timed_event_queue*
+sc_timed_event_queue::create( sc_timed_queue_kind kind )
+{
+    if ( kind == SC_TIMED_QUEUE_CALENDAR )
+        return new sc_timed_event_calendar;
+    return new sc_timed_event_heap;
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_timed_event_heap
+// ----------------------------------------------------------------------------
+
+sc_timed_event_heap::sc_timed_event_heap()
+  : m_heap( 128, sc_notify_time_compare )
+{}
+
+void
+sc_timed_event_heap::insert( sc_event_timed* et )
+{
+    m_heap.insert( et );
+}
+
+sc_event_timed*
+sc_timed_event_heap::top()
+{
+    return m_heap.top();
+}
+
+sc_event_timed*
+sc_timed_event_heap::extract_top()
+{
+    return m_heap.extract_top();
+}
+
+int
+sc_timed_event_heap::size() const
+{
+    return m_heap.size();
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_timed_event_calendar
+// ----------------------------------------------------------------------------
+
+inline sc_dt::uint64
+sc_timed_event_calendar::time_of( const sc_event_timed* et )
+{
+    return et->m_notify_time.value();
+}
+
+inline bool
+sc_timed_event_calendar::earlier( const sc_event_timed* et1,
+                                  const sc_event_timed* et2 )
+{
+    return time_of( et1 ) < time_of( et2 );
+}
+
+sc_timed_event_calendar::sc_timed_event_calendar()
+  : m_heads( SC_CALENDAR_MIN_BUCKETS, (sc_event_timed*)0 ),
+    m_tails( SC_CALENDAR_MIN_BUCKETS, (sc_event_timed*)0 ),
+    m_mask( SC_CALENDAR_MIN_BUCKETS - 1 ),
+    m_width( SC_CALENDAR_INIT_WIDTH ),
+    m_cur( 0 ),
+    m_slot( 0 ),
+    m_located( false ),
+    m_size( 0 ),
+    m_resized()
+{}
+
+void
+sc_timed_event_calendar::insert( sc_event_timed* et )
+{
+    if ( (unsigned int)m_size >= 2 * ( m_mask + 1 ) )
+        resize( 2 * ( m_mask + 1 ) );
+
+    // all notifications are at or after m_slot; an earlier one, or one
+    // before the located top, becomes the top
+    sc_dt::uint64 t = time_of( et );
+    bool top = m_size == 0 || t < m_slot ||
+               ( m_located && t < time_of( m_heads[m_cur] ) );
+
+    link( et );
+    m_size++;
+
+    if ( top )
+    {
+        m_cur = bucket_of( t );
+        m_slot = slot_of( t );
+        m_located = true;
+    }
+}
+
+sc_event_timed*
+sc_timed_event_calendar::top()
+{
+    locate();
+    return m_size != 0 ? m_heads[m_cur] : 0;
+}
+
+sc_event_timed*
+sc_timed_event_calendar::extract_top()
+{
+    locate();
+    sc_event_timed* et = m_heads[m_cur];
+    m_heads[m_cur] = et->m_next;
+    if ( m_heads[m_cur] == 0 )
+        m_tails[m_cur] = 0;
+    et->m_next = 0;
+    m_size--;
+    m_located = false;
+
+    if ( m_mask + 1 > SC_CALENDAR_MIN_BUCKETS &&
+         (unsigned int)m_size < ( m_mask + 1 ) / 8 )
+        resize( ( m_mask + 1 ) / 2 );
+    return et;
+}
+
+int
+sc_timed_event_calendar::size() const
+{
+    return m_size;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_timed_event_calendar::link"
+// |
+// | This method puts et into the list of its bucket, after all notifications
+// | of the same or an earlier time. Appending, the common case, takes the
+// | tail of the list.
+// +----------------------------------------------------------------------------
+void
+sc_timed_event_calendar::link( sc_event_timed* et )
+{
+    sc_dt::uint64   t = time_of( et );
+    unsigned int    b = bucket_of( t );
+    sc_event_timed* tail_p = m_tails[b];
+
+    if ( tail_p == 0 || time_of( tail_p ) <= t )
+    {
+        et->m_next = 0;
+        if ( tail_p == 0 )
+            m_heads[b] = et;
+        else
+            tail_p->m_next = et;
+        m_tails[b] = et;
+        return;
+    }
+
+    // the tail is later than t, so the search stops before it
+    sc_event_timed** link_p = &m_heads[b];
+    while ( time_of( *link_p ) <= t )
+        link_p = &(*link_p)->m_next;
+    et->m_next = *link_p;
+    *link_p = et;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_timed_event_calendar::locate"
+// |
+// | This method moves m_cur to the bucket of the earliest notification: it
+// | visits the buckets from m_cur on, each with the next slot, until the
+// | head of one falls into its slot. If none does within a whole round (a
+// | "year"), the earliest head is searched directly.
+// +----------------------------------------------------------------------------
+void
+sc_timed_event_calendar::locate()
+{
+    if ( m_located || m_size == 0 )
+        return;
+
+    const sc_dt::uint64 end_of_time = ~(sc_dt::uint64)0;
+    unsigned int        b = m_cur;
+    sc_dt::uint64       slot = m_slot;
+
+    for ( unsigned int i = 0; i <= m_mask; i++ )
+    {
+        // the heads of the buckets ahead are not earlier than their slots
+        sc_event_timed* et = m_heads[b];
+        if ( et != 0 && time_of( et ) - slot < m_width )
+        {
+            m_cur = b;
+            m_slot = slot;
+            m_located = true;
+            return;
+        }
+        if ( slot > end_of_time - m_width )
+            break;
+        b = ( b + 1 ) & m_mask;
+        slot += m_width;
+    }
+
+    sc_event_timed* first_p = 0;
+    for ( b = 0; b <= m_mask; b++ )
+    {
+        if ( m_heads[b] != 0 &&
+             ( first_p == 0 || earlier( m_heads[b], first_p ) ) )
+            first_p = m_heads[b];
+    }
+    m_cur = bucket_of( time_of( first_p ) );
+    m_slot = slot_of( time_of( first_p ) );
+    m_located = true;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_timed_event_calendar::resize"
+// |
+// | This method spreads the notifications over num_buckets buckets, with a
+// | slot width of three times the mean distance of the earliest
+// | notifications, up to SC_CALENDAR_WIDTH_SAMPLE distinct times. It keeps
+// | the width if all notifications share one time.
+// +----------------------------------------------------------------------------
+void
+sc_timed_event_calendar::resize( unsigned int num_buckets )
+{
+    // take the notifications out in time order; equal times share a bucket,
+    // so the stable sort keeps them in insertion order
+    m_resized.clear();
+    for ( unsigned int b = 0; b <= m_mask; b++ )
+        for ( sc_event_timed* et = m_heads[b]; et != 0; et = et->m_next )
+            m_resized.push_back( et );
+    std::stable_sort( m_resized.begin(), m_resized.end(), earlier );
+
+    unsigned int distinct = 0;
+    std::size_t  last = 0;
+    for ( std::size_t i = 1; i < m_resized.size() &&
+                             distinct < SC_CALENDAR_WIDTH_SAMPLE; i++ )
+    {
+        if ( time_of( m_resized[i] ) != time_of( m_resized[i - 1] ) )
+        {
+            distinct++;
+            last = i;
+        }
+    }
+    if ( distinct != 0 )
+    {
+        // notifications of equal times count with a distance of 0, so that
+        // a slot does not gather several long runs of equal times
+        sc_dt::uint64 span = time_of( m_resized[last] ) -
+                             time_of( m_resized[0] );
+        m_width = std::max<sc_dt::uint64>( 1, 3 * ( span / last ) );
+    }
+
+    m_heads.assign( num_buckets, (sc_event_timed*)0 );
+    m_tails.assign( num_buckets, (sc_event_timed*)0 );
+    m_mask = num_buckets - 1;
+    for ( std::size_t i = 0; i < m_resized.size(); i++ )
+        link( m_resized[i] );
+
+    m_located = false;
+    if ( !m_resized.empty() )
+    {
+        m_cur = bucket_of( time_of( m_resized[0] ) );
+        m_slot = slot_of( time_of( m_resized[0] ) );
+        m_located = true;
+    }
+    m_resized.clear();
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
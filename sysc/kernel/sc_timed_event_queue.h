@@ -0,0 +1,184 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_timed_event_queue.h -- The queue of the timed event notifications: a
+                            binary heap or a calendar queue.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_TIMED_EVENT_QUEUE_H
+#define SC_TIMED_EVENT_QUEUE_H
+
+#include "sysc/utils/sc_pq.h"
+#include "sysc/datatypes/int/sc_nbdefs.h"
+
+#include <vector>
+
+namespace sc_core {
+
+class sc_event_timed;
+
+/**
+ *  \brief Environment variable selecting the timed event queue: "heap" (the
+ *         default) or "calendar".
+ */
+#ifndef _SYSC_TIMED_QUEUE_ENV_VAR
+#define _SYSC_TIMED_QUEUE_ENV_VAR "SYSC_TIMED_QUEUE"
+#endif
+
+/**
+ *  \brief Kinds of timed event queues.
+ */
+enum sc_timed_queue_kind {
+    SC_TIMED_QUEUE_HEAP = 0,
+    SC_TIMED_QUEUE_CALENDAR
+};
+
+/**************************************************************************//**
+ *  \class sc_timed_event_queue
+ *
+ *  \brief A priority queue of timed event notifications, the earliest
+ *         notification time on top.
+ *
+ *  The queue owns no notifications; the kernel deletes the ones it takes
+ *  out. Cancelled notifications stay in the queue with a null event.
+ *****************************************************************************/
+
+class sc_timed_event_queue
+{
+public:
+
+    virtual ~sc_timed_event_queue() {}
+
+    virtual void            insert( sc_event_timed* et ) = 0;
+    virtual sc_event_timed* top() = 0;
+    virtual sc_event_timed* extract_top() = 0;
+    virtual int             size() const = 0;
+
+    /**
+     *  \brief A new queue of the kind named by _SYSC_TIMED_QUEUE_ENV_VAR.
+     */
+    static sc_timed_event_queue* create();
+
+    static sc_timed_event_queue* create( sc_timed_queue_kind kind );
+};
+
+/**************************************************************************//**
+ *  \class sc_timed_event_heap
+ *
+ *  \brief The binary heap of the reference simulator, O(log n) per insert
+ *         and extraction.
+ *****************************************************************************/
+
+class sc_timed_event_heap : public sc_timed_event_queue
+{
+public:
+
+    sc_timed_event_heap();
+
+    virtual void            insert( sc_event_timed* et );
+    virtual sc_event_timed* top();
+    virtual sc_event_timed* extract_top();
+    virtual int             size() const;
+
+private:
+
+    sc_ppq<sc_event_timed*> m_heap;
+};
+
+/**************************************************************************//**
+ *  \class sc_timed_event_calendar
+ *
+ *  \brief A calendar queue (R. Brown, CACM 31(10), 1988), O(1) amortized
+ *         per insert and extraction.
+ *
+ *  Time is cut into slots of m_width resolution units, and the slots are
+ *  spread over a power of two of buckets, each a list of notifications
+ *  sorted by time. Notifications of the same time come out in insertion
+ *  order. The lists are linked through sc_event_timed::m_next, so the
+ *  nodes are the notifications themselves, from the free list of
+ *  sc_event_timed. The number of buckets follows the size of the queue,
+ *  and the slot width is set, on every resize, to three times the mean
+ *  distance of the earliest notifications.
+ *****************************************************************************/
+
+class sc_timed_event_calendar : public sc_timed_event_queue
+{
+public:
+
+    sc_timed_event_calendar();
+
+    virtual void            insert( sc_event_timed* et );
+    virtual sc_event_timed* top();
+    virtual sc_event_timed* extract_top();
+    virtual int             size() const;
+
+private:
+
+    static inline sc_dt::uint64 time_of( const sc_event_timed* et );
+    static inline bool earlier( const sc_event_timed* et1,
+                                const sc_event_timed* et2 );
+
+    unsigned int bucket_of( sc_dt::uint64 t ) const
+        { return (unsigned int)( t / m_width ) & m_mask; }
+
+    sc_dt::uint64 slot_of( sc_dt::uint64 t ) const
+        { return t - t % m_width; }
+
+    void link( sc_event_timed* et );
+    void locate();
+    void resize( unsigned int num_buckets );
+
+private:
+
+    std::vector<sc_event_timed*> m_heads;
+    std::vector<sc_event_timed*> m_tails;
+    unsigned int                 m_mask;        // number of buckets - 1
+    sc_dt::uint64                m_width;       // of a slot
+    unsigned int                 m_cur;         // bucket searched first
+    sc_dt::uint64                m_slot;        // start of its current slot
+    bool                         m_located;     // m_cur holds the top
+    int                          m_size;
+    std::vector<sc_event_timed*> m_resized;     // kept for resize()
+
+private:
+
+    // disabled
+    sc_timed_event_calendar( const sc_timed_event_calendar& );
+    sc_timed_event_calendar& operator = ( const sc_timed_event_calendar& );
+};
+
+} // namespace sc_core
+
+#endif // SC_TIMED_EVENT_QUEUE_H
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -0,0 +1,207 @@
+/*****************************************************************************
+
+  The following code is derived, directly or indirectly, from the SystemC
+  source code Copyright (c) 1996-2014 by all Contributors.
+  All Rights reserved.
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC Open Source License (the "License");
+  You may not use this file except in compliance with such restrictions and
+  limitations. You may obtain instructions on how to receive a copy of the
+  License at http://www.accellera.org/. Software distributed by Contributors
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_temporary.cpp -- Per-thread state of the temporary pools.
+
+  Original Author: RISC Project, University of California, Irvine
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/utils/sc_temporary.h"
+
+#include <cstring>
+#include <vector>
+
+#if !defined(WIN32)
+#include <pthread.h>
+#endif
+
+namespace sc_core {
+
+// the table of the calling thread, indexed by the number of a pool
+
+SC_THREAD_LOCAL_ sc_temp_state* sc_temp_states = 0;
+SC_THREAD_LOCAL_ std::size_t    sc_temp_states_n = 0;
+
+// the pools are numbered during static initialization, before any
+// constructor of this file may have run, so this state is all constant
+// initialized: the number of pools, and the functions freeing their storage
+
+typedef void (*sc_temp_free_fn)( void* );
+
+static std::size_t      sc_temp_ids = 0;
+static std::size_t      sc_temp_free_n = 0;
+static sc_temp_free_fn* sc_temp_free_fns = 0;
+
+#if !defined(WIN32)
+
+static pthread_mutex_t sc_temp_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t  sc_temp_once = PTHREAD_ONCE_INIT;
+static pthread_key_t   sc_temp_key;
+
+#endif // !defined(WIN32)
+
+// the tables given back by threads that block, guarded by sc_temp_mutex
+struct sc_temp_table {
+    sc_temp_state* m_states;
+    std::size_t    m_n;
+};
+static std::vector<sc_temp_table>* sc_temp_free_tables = 0;
+
+#if !defined(WIN32)
+
+// free the temporaries of an exiting thread
+
+static void
+sc_temp_exit( void* states_p )
+{
+    sc_temp_state* states = (sc_temp_state*)states_p;
+    std::size_t    states_n = sc_temp_states_n;
+
+    pthread_mutex_lock( &sc_temp_mutex );
+    for ( std::size_t id = 0; id < states_n; id++ )
+    {
+        if ( states[id].m_bgn_p != 0 && states[id].m_size != 0 )
+            sc_temp_free_fns[id]( states[id].m_bgn_p );
+    }
+    pthread_mutex_unlock( &sc_temp_mutex );
+    delete [] states;
+    sc_temp_states = 0;
+    sc_temp_states_n = 0;
+}
+
+static void
+sc_temp_create_key()
+{
+    pthread_key_create( &sc_temp_key, &sc_temp_exit );
+}
+
+#endif // !defined(WIN32)
+
+std::size_t
+sc_temp_new_id( void (*free_fn)( void* ) )
+{
+#if !defined(WIN32)
+    pthread_mutex_lock( &sc_temp_mutex );
+#endif
+    std::size_t id = sc_temp_ids++;
+    if ( id >= sc_temp_free_n )
+    {
+        std::size_t new_n = sc_temp_free_n ? 2 * sc_temp_free_n : 32;
+        sc_temp_free_fn* fns = new sc_temp_free_fn[new_n];
+        if ( sc_temp_free_n != 0 )
+            std::memcpy( fns, sc_temp_free_fns,
+                         sc_temp_free_n * sizeof( *fns ) );
+        delete [] sc_temp_free_fns;
+        sc_temp_free_fns = fns;
+        sc_temp_free_n = new_n;
+    }
+    sc_temp_free_fns[id] = free_fn;
+#if !defined(WIN32)
+    pthread_mutex_unlock( &sc_temp_mutex );
+#endif
+    return id;
+}
+
+// a thread without a table takes one given back by another thread, if any;
+// the table grows to all pools numbered so far, so it grows once unless
+// pools are constructed during simulation
+
+sc_temp_state&
+sc_temp_grow( std::size_t id )
+{
+    if ( sc_temp_states == 0 )
+    {
+#if !defined(WIN32)
+        pthread_mutex_lock( &sc_temp_mutex );
+#endif
+        if ( sc_temp_free_tables != 0 && !sc_temp_free_tables->empty() )
+        {
+            sc_temp_states = sc_temp_free_tables->back().m_states;
+            sc_temp_states_n = sc_temp_free_tables->back().m_n;
+            sc_temp_free_tables->pop_back();
+        }
+#if !defined(WIN32)
+        pthread_mutex_unlock( &sc_temp_mutex );
+#endif
+    }
+
+    if ( id >= sc_temp_states_n )
+    {
+        std::size_t new_n = __atomic_load_n( &sc_temp_ids, __ATOMIC_ACQUIRE );
+        if ( new_n <= id )
+            new_n = id + 1;
+
+        sc_temp_state* states = new sc_temp_state[new_n];
+        std::memset( states, 0, new_n * sizeof( sc_temp_state ) );
+        if ( sc_temp_states_n != 0 )
+            std::memcpy( states, sc_temp_states,
+                         sc_temp_states_n * sizeof( sc_temp_state ) );
+        delete [] sc_temp_states;
+        sc_temp_states = states;
+        sc_temp_states_n = new_n;
+    }
+
+#if !defined(WIN32)
+    pthread_once( &sc_temp_once, &sc_temp_create_key );
+    pthread_setspecific( sc_temp_key, sc_temp_states );
+#endif
+    return sc_temp_states[id];
+}
+
+// called by a thread about to block: another thread may use the table until
+// this one takes a table again
+
+void
+sc_temp_release()
+{
+    if ( sc_temp_states == 0 )
+        return;
+
+#if !defined(WIN32)
+    pthread_setspecific( sc_temp_key, 0 );
+    pthread_mutex_lock( &sc_temp_mutex );
+#endif
+    if ( sc_temp_free_tables == 0 )
+        sc_temp_free_tables = new std::vector<sc_temp_table>;
+    sc_temp_table table;
+    table.m_states = sc_temp_states;
+    table.m_n = sc_temp_states_n;
+    sc_temp_free_tables->push_back( table );
+#if !defined(WIN32)
+    pthread_mutex_unlock( &sc_temp_mutex );
+#endif
+    sc_temp_states = 0;
+    sc_temp_states_n = 0;
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -29,8 +29,62 @@
 
 #include <cstddef>                // std::size_t
 
+#include "sysc/kernel/sc_cmnhdr.h"
+
 namespace sc_core {
 
+//------------------------------------------------------------------------------
+// sc_temp_state - PER-THREAD STATE OF A TEMPORARY POOL
+//
+// Concurrently running simulation threads must not rotate through the same
+// temporaries, so each thread keeps its own storage and allocation index for
+// every sc_byte_heap and sc_vpool, without any lock. The pools are numbered
+// when they are constructed, and a thread finds its state in its own table,
+// sc_temp_states, by that number. The table and the storage are allocated by
+// the thread itself on its first allocation from a pool.
+//
+// A table is not tied to its thread for good: a thread that blocks gives it
+// back with sc_temp_release(), and the next thread without a table takes it
+// over. With one OS thread per process (the pthread coroutine package), there
+// are thus about as many tables as threads running at once, not one per
+// process. Temporaries do not live across a wait(), as with the single shared
+// pools of the original implementation.
+//
+// sc_temp_state& sc_temp_state_of( std::size_t id )
+//   This function returns the state of the calling thread for pool id,
+//   taking a released table or extending the table of the thread if
+//   necessary.
+//
+// void sc_temp_release()
+//   This function gives the table of the calling thread back for use by
+//   other threads.
+//------------------------------------------------------------------------------
+struct sc_temp_state {
+    void*       m_bgn_p; // Storage of this thread, 0 until first used.
+    std::size_t m_next;  // Next entry (sc_vpool) or byte (sc_byte_heap).
+    std::size_t m_size;  // Size of m_bgn_p, 0 if not owned by the thread.
+};
+
+extern SC_THREAD_LOCAL_ sc_temp_state* sc_temp_states;
+extern SC_THREAD_LOCAL_ std::size_t    sc_temp_states_n;
+
+// number a new pool; free_fn frees the storage of a thread
+extern std::size_t sc_temp_new_id( void (*free_fn)( void* ) );
+
+// take or extend the table of the calling thread to hold id
+extern sc_temp_state& sc_temp_grow( std::size_t id );
+
+// give the table of the calling thread back
+extern void sc_temp_release();
+
+inline sc_temp_state& sc_temp_state_of( std::size_t id )
+{
+    if ( SC_LIKELY_( id < sc_temp_states_n ) )
+        return sc_temp_states[id];
+    return sc_temp_grow( id );
+}
+
+
 //------------------------------------------------------------------------------
 // sc_byte_heap - CLASS MANAGING A TEMPORARY HEAP OF BYTES
 //
@@ -40,82 +94,104 @@ namespace sc_core {
 // be assumed as permanent. Allocations are double-word aligned. This is
 // raw storage, so objects which contain virtual methods cannot be allocated
 // with this object. See the sc_vpool object for that type of storage 
-// allocation.
+// allocation. Each thread allocates from a heap of its own (see
+// sc_temp_state).
 //
 // char* allocate( int size )
 //   This method returns a pointer to block of size bytes. The block
-//   returned is the next available one in the heap. If the current heap
-//   cannot fullfil the request it will be rewound and storage allocated from
-//   its start. All allocations start on an 8-byte boundary.
+//   returned is the next available one in the heap of the calling thread.
+//   If the current heap cannot fullfil the request it will be rewound and
+//   storage allocated from its start. All allocations start on an 8-byte
+//   boundary.
 //       size = number of bytes to be allocated.
 //
 // void initialize( int heap_size=0x100000 )
-//   This method allocates the storage to be managed. If there is already
-//   a block of storage under management it is freed. If no argument is
-//   provided for the heap size, a megabyte will be allocated.
+//   This method sets the size of the heaps. The heap of the calling thread
+//   is freed if it exists; the heaps of the other threads keep their size.
+//   If no argument is provided for the heap size, a megabyte will be used.
 //       heap_size = number of bytes to allocate for the heap.
 //
 // unsigned int length()
-//   This method returns the size of this object's heap in bytes.
+//   This method returns the size of this object's heaps in bytes.
 //
 // sc_byte_heap()
 //   This is the non-initialized object instance constructor. It does not 
-//   allocate the heap storage, that is done by the initialize() method.
+//   set the heap size, that is done by the initialize() method.
 //
 // sc_byte_heap(int)
-//   This is the initializing object instance constructor. It does allocates
-//   a heap of the specified number of bytes.
+//   This is the initializing object instance constructor. The heap of a
+//   thread is allocated with the specified number of bytes when the thread
+//   first allocates from it.
 //       heap_size = number of bytes to allocate for the heap.
 //------------------------------------------------------------------------------
 class sc_byte_heap {
   public:
-    char*  m_bgn_p;  // Beginning of heap storage.
-    char*  m_end_p;  // End of heap storage.
-    char*  m_next_p; // Next heap location to be allocated.
+    std::size_t m_id;   // Index of the per-thread state of this heap.
+    std::size_t m_size; // Size of the heaps allocated from now on.
 
     inline char* allocate( std::size_t bytes_n )
     {
-        char*   result_p;
+        sc_temp_state& state = sc_temp_state_of( m_id );
+        if ( SC_UNLIKELY_( state.m_bgn_p == 0 ) )
+        {
+            state.m_bgn_p = new char[m_size];
+            state.m_size = m_size;
+            state.m_next = 0;
+        }
+
+        char*       bgn_p = (char*)state.m_bgn_p;
+        std::size_t next;
         bytes_n = (bytes_n + 7) & ((std::size_t)(-8));
-        result_p = m_next_p;
-        m_next_p += bytes_n;
-        if ( m_next_p >= m_end_p )
+        next = state.m_next + bytes_n;
+        if ( next >= state.m_size )
         {
-            result_p = m_bgn_p;
-            m_next_p = m_bgn_p + bytes_n;
+            state.m_next = bytes_n;
+            return bgn_p;
         }
-        return result_p; 
+        state.m_next = next;
+        return bgn_p + next - bytes_n;
     }
 
     inline void initialize( std::size_t heap_size=0x100000 )
     {
-        delete [] m_bgn_p;
-        m_bgn_p = new char[heap_size];
-        m_end_p = &m_bgn_p[heap_size];
-        m_next_p = m_bgn_p;
+        release();
+        m_size = heap_size;
     }
 
 	inline std::size_t length()
 	{
-		return (std::size_t)(m_end_p - m_bgn_p);
+		return m_size;
 	}
 
 	inline sc_byte_heap() : 
-	    m_bgn_p(0), m_end_p(0), m_next_p(0)
+	    m_id( sc_temp_new_id( &free_heap ) ), m_size(0)
 	{
 	}
 
 		inline sc_byte_heap( std::size_t heap_size ) :
-	    m_bgn_p(0), m_end_p(0), m_next_p(0)
+	    m_id( sc_temp_new_id( &free_heap ) ), m_size(heap_size)
 	{
-		initialize( heap_size );
 	}
 
 	inline ~sc_byte_heap()
 	{
-		delete [] m_bgn_p;
+		release();
 	}
 
+  private:
+
+	// free the heap of the calling thread
+	inline void release()
+	{
+		sc_temp_state& state = sc_temp_state_of( m_id );
+		delete [] (char*)state.m_bgn_p;
+		state.m_bgn_p = 0;
+	}
+
+	static void free_heap( void* heap_p )
+	{
+		delete [] (char*)heap_p;
+	}
 };
 
 
@@ -123,43 +199,44 @@ class sc_byte_heap {
 // sc_vpool<T> - CLASS MANAGING A TEMPORARY VECTOR OF CLASS T INSTANCES
 //
 // This class implements a fixed pool of objects contained in a vector. These
-// objects are allocated via the allocate() method. An index, m_pool_i, 
-// indicates the next object to be allocated. The vector is a power of 2 in
-// size, and this fact is used to wrap the list when m_pool_i reaches the
-// end of the vector.  
+// objects are allocated via the allocate() method. An index, m_next of the
+// sc_temp_state of the calling thread, indicates the next object to be
+// allocated. Each thread has a vector of its own, allocated on its first
+// allocation. The vector is a power of 2 in size, and this fact is used to
+// wrap the list when the index reaches the end of the vector.  
 // 
 // sc_vpool( int log2, T* pool_p=0 )
 //   This is the object instance constructor for this class. It configures
-//   the object to manage a vector of 2**log2 entries. If a vector is 
-//   not supplied one will be allocated.
+//   the object to manage vectors of 2**log2 entries. If a vector is 
+//   supplied it is used by the first thread to allocate from the pool.
 //     log2   =  the log base two of the size of the vector.
 //     pool_p -> vector of 2**log2 entries to be managed or 0.
 //
 // ~sc_vpool()
-//   This is the object instance destructor for this class. It frees the
-//   block of storage which was being managed.
+//   This is the object instance destructor for this class. The vectors
+//   of the threads are freed when the threads exit.
 //
 // T* allocate()
-//   This method returns the address of the next entry in the vector, m_pool_p, 
-//   pointed to by the index, m_pool_i, and updates that index. The index
-//   update consists of adding 1 to m_pool_i and masking it by m_wrap.
+//   This method returns the address of the next entry in the vector of the
+//   calling thread, and updates its index. The index update consists of
+//   adding 1 to it and masking it by m_wrap.
 // 
 // void reset()
-//   This method resets the allocation index, m_pool_i, to point to the start
-//   of the vector of objects under management. This call is not usually made
-//   since there are a fixed number of entries and the index wraps. However,
-//   for diagnostics tests it is convenient to be able to reset to the start
+//   This method resets the allocation index of the calling thread to point
+//   to the start of its vector. This call is not usually made since there
+//   are a fixed number of entries and the index wraps. However, for
+//   diagnostics tests it is convenient to be able to reset to the start
 //   of the vector.
 //
 // int size()
 //   This method returns the number of object instances contained in the
-//   vector being managed by this object instance.
+//   vectors being managed by this object instance.
 //------------------------------------------------------------------------------
 template<class T>
 class sc_vpool {
   protected:
-	std::size_t m_pool_i;	// Index of next entry to m_pool_m to provide.
-	T*          m_pool_p;	// Vector of temporaries.
+	std::size_t m_id;	// Index of the per-thread state of this pool.
+	T*          m_pool_p;	// Vector supplied to the constructor, or 0.
 	std::size_t m_wrap;		// Mask to wrap vector index.
 
   public:
@@ -168,11 +245,15 @@ class sc_vpool {
 	inline T* allocate();
 	inline void reset();
 	inline std::size_t size();
+
+  private:
+	void new_pool( sc_temp_state& state );
+	static void free_pool( void* pool_p );
 };
 
 template<class T> sc_vpool<T>::sc_vpool( int log2, T* pool_p )
-  : m_pool_i( 0 )
-  , m_pool_p( pool_p ? pool_p : new T[static_cast<std::size_t>(1) << log2] )
+  : m_id( sc_temp_new_id( &free_pool ) )
+  , m_pool_p( pool_p )
   , m_wrap( ~(static_cast<std::size_t>(-1) << log2) )
 {
 	// if ( log2 > 32 ) SC_REPORT_ERROR(SC_ID_POOL_SIZE_, "");
@@ -187,14 +268,17 @@ template<class T> T* sc_vpool<T>::allocate()
 {
 	T* result_p;	// Entry to return.
 
-	result_p = &m_pool_p[m_pool_i];
-	m_pool_i = (m_pool_i + 1) & m_wrap;
+	sc_temp_state& state = sc_temp_state_of( m_id );
+	if ( SC_UNLIKELY_( state.m_bgn_p == 0 ) )
+		new_pool( state );
+	result_p = (T*)state.m_bgn_p + state.m_next;
+	state.m_next = (state.m_next + 1) & m_wrap;
 	return result_p;
 }
 
 template<class T> void sc_vpool<T>::reset()
 {
-	m_pool_i = 0;
+	sc_temp_state_of( m_id ).m_next = 0;
 }
 
 template<class T> std::size_t sc_vpool<T>::size()
@@ -202,6 +286,27 @@ template<class T> std::size_t sc_vpool<T>::size()
 	return m_wrap + 1;
 }
 
+// the supplied vector goes to the first thread, and is not freed by it
+
+template<class T> void sc_vpool<T>::new_pool( sc_temp_state& state )
+{
+	T* pool_p = __atomic_exchange_n( &m_pool_p, (T*)0, __ATOMIC_ACQ_REL );
+	state.m_next = 0;
+	if ( pool_p != 0 )
+	{
+		state.m_bgn_p = pool_p;
+		state.m_size = 0;
+		return;
+	}
+	state.m_bgn_p = new T[m_wrap + 1];
+	state.m_size = m_wrap + 1;
+}
+
+template<class T> void sc_vpool<T>::free_pool( void* pool_p )
+{
+	delete [] (T*)pool_p;
+}
+
 } // namespace sc_core
 
 // $Log: sc_temporary.h,v $